@@ -116,6 +116,17 @@ export namespace SoC
         { allocator::deallocate(void_ptr, n) } -> ::std::same_as<void>;
     };
 
+    /**
+     * @brief 判断allocator是否支持不带大小的释放，要求满足：
+     * - SoC::is_static_allocator<allocator>，且
+     * - 存在非模板的static void allocator::deallocate(void*)，块大小由分配器通过元数据获取，如SoC::heap_allocator_impl
+     * @note 模板形式的deallocate(type*, std::size_t = 1)也可以接受void*实参，因此通过取地址要求非模板重载
+     * @tparam allocator 要判断的类型
+     */
+    template <typename allocator>
+    concept is_unsized_deallocate_allocator =
+        ::SoC::is_static_allocator<allocator> && requires { static_cast<void (*)(void*)>(&allocator::deallocate); };
+
     /**
      * @brief 判断type是否为无异常分配器，要求满足：
      * - SoC::is_allocator<type>，且
@@ -125,6 +136,103 @@ export namespace SoC
     template <typename type>
     concept is_noexcept_allocator = ::SoC::is_allocator<type> && ::SoC::detail::is_allocator_without_exception<type>;
 
+    /**
+     * @brief 内存区域的访问能力
+     *
+     */
+    enum class memory_capability : ::std::uint8_t
+    {
+        /// 可被DMA访问，如主内存
+        dma,
+        /// 仅CPU可访问，如ccmram
+        cpu_only
+    };
+
+    /**
+     * @brief 分配器所分配内存的访问能力，分配器通过静态成员capability声明，未声明时视为仅CPU可访问
+     *
+     * @tparam allocator_t 分配器类型
+     */
+    template <::SoC::is_allocator allocator_t>
+    constexpr inline ::SoC::memory_capability allocator_capability{::SoC::memory_capability::cpu_only};
+
+    template <::SoC::is_allocator allocator_t>
+        requires requires { allocator_t::capability; }
+    constexpr inline ::SoC::memory_capability allocator_capability<allocator_t>{allocator_t::capability};
+
+    /**
+     * @brief 分配器为type类型对象所分配内存的访问能力，按类型路由的分配器通过静态成员模板capability_for声明，
+     * 未声明时与SoC::allocator_capability相同
+     *
+     * @tparam allocator_t 分配器类型
+     * @tparam type 对象类型
+     */
+    template <::SoC::is_allocator allocator_t, typename type>
+    constexpr inline ::SoC::memory_capability allocator_capability_for{::SoC::allocator_capability<allocator_t>};
+
+    template <::SoC::is_allocator allocator_t, typename type>
+        requires requires { allocator_t::template capability_for<type>; }
+    constexpr inline ::SoC::memory_capability allocator_capability_for<allocator_t, type>{
+        allocator_t::template capability_for<type>};
+
+    /**
+     * @brief 判断allocator_t分配的内存是否可被DMA访问
+     *
+     * @tparam allocator_t 要判断的类型
+     */
+    template <typename allocator_t>
+    concept is_dma_allocator =
+        ::SoC::is_allocator<allocator_t> && ::SoC::allocator_capability<allocator_t> == ::SoC::memory_capability::dma;
+
+    /**
+     * @brief 带访问能力标记的连续内存区域，用于在编译期拒绝将仅CPU可访问的缓冲区交给DMA
+     *
+     * @tparam type 元素类型
+     * @tparam capability_v 内存区域的访问能力
+     */
+    template <typename type, ::SoC::memory_capability capability_v>
+    struct memory_span : ::std::span<type>
+    {
+        /// 内存区域的访问能力
+        constexpr inline static auto capability{capability_v};
+
+        /**
+         * @brief 标记一段已知访问能力的内存区域
+         *
+         * @param ptr 内存区域首指针
+         * @param n 元素个数
+         */
+        constexpr inline explicit memory_span(type* ptr, ::std::size_t n) noexcept : ::std::span<type>{ptr, n} {}
+    };
+
+    /// 可被DMA访问的连续内存区域
+    template <typename type>
+    using dma_span = ::SoC::memory_span<type, ::SoC::memory_capability::dma>;
+
+    /**
+     * @brief 通过分配器分配n个type类型对象所需的空间，并按分配器为type分配的内存的访问能力标记
+     *
+     * @tparam type 要分配的类型
+     * @param allocator 分配器
+     * @param n 要分配的对象个数
+     * @return 带访问能力标记的内存区域，元素个数为n，可通过allocator.deallocate(span.data(), span.size())释放
+     */
+    template <typename type, ::SoC::is_allocator allocator_t>
+    constexpr inline ::SoC::memory_span<type, ::SoC::allocator_capability_for<allocator_t, type>>
+        allocate_span(allocator_t allocator, ::std::size_t n) noexcept(::SoC::is_noexcept_allocator<allocator_t>)
+    {
+        using span_t = ::SoC::memory_span<type, ::SoC::allocator_capability_for<allocator_t, type>>;
+        return span_t{allocator.template allocate<type>(n).ptr, n};
+    }
+
+    /**
+     * @brief 判断类型是否需要被DMA访问，供SoC::basic_routing_allocator路由使用，可对用户类型特化
+     *
+     * @tparam type 要判断的类型
+     */
+    template <typename type>
+    constexpr inline bool requires_dma_access{false};
+
     /**
      * @brief 将SoC分配器包装为标准分配器
      *
@@ -191,6 +299,118 @@ export namespace SoC
         }
     };
 
+    /**
+     * @brief 按对象类型路由的分配器，SoC::requires_dma_access为true的类型从可被DMA访问的内存分配，
+     * 其余对象和不带类型的分配（如协程帧）从仅CPU可访问的内存分配，以便为DMA缓冲区留出主内存
+     *
+     * @tparam dma_allocator_t 可被DMA访问的静态分配器类型
+     * @tparam cpu_allocator_t 用于仅CPU访问对象的静态分配器类型
+     */
+    template <::SoC::is_static_allocator dma_allocator_t, ::SoC::is_static_allocator cpu_allocator_t>
+        requires (::SoC::is_dma_allocator<dma_allocator_t>)
+    struct basic_routing_allocator
+    {
+    private:
+        /// 上游分配器是否都不抛出异常
+        constexpr inline static bool is_noexcept{::SoC::is_noexcept_allocator<dma_allocator_t> &&
+                                                 ::SoC::is_noexcept_allocator<cpu_allocator_t>};
+
+    public:
+        /// 不带类型的分配总是路由到cpu_allocator_t，因此整体按其访问能力标记
+        constexpr inline static auto capability{::SoC::allocator_capability<cpu_allocator_t>};
+
+        /**
+         * @brief 为type类型对象分配的内存的访问能力，需要DMA访问的类型路由到dma_allocator_t
+         *
+         * @tparam type 对象类型
+         */
+        template <typename type>
+        constexpr inline static auto capability_for{
+            ::SoC::requires_dma_access<type> ? ::SoC::memory_capability::dma : capability};
+
+        /**
+         * @brief 从仅CPU可访问的内存分配size个字节
+         *
+         * @param size 要分配的字节数
+         * @return 内存区域首指针
+         */
+        inline static void* allocate(::std::size_t size) noexcept(is_noexcept) { return cpu_allocator_t::allocate(size); }
+
+        /**
+         * @brief 分配一个type类型对象所需的空间
+         *
+         * @tparam type 要分配的类型
+         * @return 内存区域首指针
+         */
+        template <typename type>
+        inline static type* allocate() noexcept(is_noexcept)
+        {
+            if constexpr(::SoC::requires_dma_access<type>) { return dma_allocator_t::template allocate<type>(); }
+            else
+            {
+                return cpu_allocator_t::template allocate<type>();
+            }
+        }
+
+        /**
+         * @brief 分配至少连续n个type类型对象所需的空间
+         *
+         * @tparam type 要分配的类型
+         * @param n 要分配的对象个数
+         * @return 内存区域首指针和实际可容纳对象数
+         */
+        template <typename type>
+        inline static ::SoC::allocation_result<type*> allocate(::std::size_t n) noexcept(is_noexcept)
+        {
+            if constexpr(::SoC::requires_dma_access<type>) { return dma_allocator_t::template allocate<type>(n); }
+            else
+            {
+                return cpu_allocator_t::template allocate<type>(n);
+            }
+        }
+
+        /**
+         * @brief 释放ptr起连续size个字节的内存区域
+         *
+         * @param ptr 内存区域首指针
+         * @param size 要释放的字节数，需要和分配时保持一致
+         */
+        inline static void deallocate(void* ptr, ::std::size_t size) noexcept(is_noexcept)
+        {
+            cpu_allocator_t::deallocate(ptr, size);
+        }
+
+        /**
+         * @brief 释放n个type类型对象占用的空间
+         *
+         * @tparam type 要释放的类型
+         * @param ptr 内存区域首指针
+         * @param n 要释放的对象个数
+         */
+        template <typename type>
+        inline static void deallocate(type* ptr, ::std::size_t n = 1) noexcept(is_noexcept)
+        {
+            if constexpr(::SoC::requires_dma_access<type>) { dma_allocator_t::deallocate(ptr, n); }
+            else
+            {
+                cpu_allocator_t::deallocate(ptr, n);
+            }
+        }
+
+        /**
+         * @brief 比较两个分配器对象是否相同
+         *
+         * @param lhs 左操作数
+         * @param rhs 右操作数
+         * @return 分配器对象是否相同
+         */
+        constexpr inline friend bool operator== (basic_routing_allocator lhs [[maybe_unused]],
+                                                 basic_routing_allocator rhs [[maybe_unused]]) noexcept
+        {
+            return true;
+        }
+    };
+
     /**
      * @brief 适用于常量表达式的分配器
      *
@@ -254,4 +474,414 @@ export namespace SoC
             return true;
         }
     } inline constexpr constexpr_allocator;
+
+    /**
+     * @brief 协程帧回收分配器，按精确大小缓存已释放的内存块，供再次创建的协程复用
+     *
+     * 释放的内存块按大小挂入对应的侵入式空闲链表，分配时优先从大小完全相同的链表中取出，
+     * 未命中时才转发给上游分配器。适用于反复创建短生命周期协程的场景
+     * @tparam upstream_t 上游静态分配器类型
+     * @tparam class_cnt 可缓存的大小类别数，类别用尽后释放的内存块直接归还上游分配器
+     * @note 缓存的内存块按大小分配，因此对齐保证与上游分配器的allocate(std::size_t)相同；
+     * 分配器状态为全局共享，不可在中断中使用
+     */
+    template <::SoC::is_static_allocator upstream_t, ::std::size_t class_cnt = 8>
+        requires (class_cnt != 0)
+    struct frame_cache_allocator
+    {
+    private:
+        /// 空闲内存块，复用内存块首部存储链表指针
+        struct free_block
+        {
+            free_block* next;
+        };
+
+        /// 大小类别
+        struct size_class
+        {
+            /// 该类别的内存块大小，为0表示类别未使用
+            ::std::size_t size;
+            /// 空闲链表头
+            free_block* head;
+        };
+
+        /// 上游分配器是否不抛出异常
+        constexpr inline static bool is_noexcept{::SoC::is_noexcept_allocator<upstream_t>};
+
+    public:
+        /// 缓存的内存块来自上游分配器，因此访问能力与上游相同
+        constexpr inline static auto capability{::SoC::allocator_capability<upstream_t>};
+
+    private:
+        /// 各大小类别的空闲链表
+        constinit inline static ::std::array<size_class, class_cnt> classes{};
+        /// 命中缓存的分配次数
+        constinit inline static ::std::size_t hit_cnt{};
+        /// 未命中缓存的分配次数
+        constinit inline static ::std::size_t miss_cnt{};
+
+        /**
+         * @brief 查找大小为size的类别
+         *
+         * @param size 内存块大小，为0时查找未使用的类别
+         * @return 类别指针，不存在时为nullptr
+         */
+        inline static size_class* find_class(::std::size_t size) noexcept
+        {
+            for(auto&& size_class: classes)
+            {
+                if(size_class.size == size) { return &size_class; }
+            }
+            return nullptr;
+        }
+
+    public:
+        /**
+         * @brief 分配size个字节，优先复用大小相同的缓存内存块
+         *
+         * @param size 要分配的字节数
+         * @return 内存区域首指针
+         */
+        inline static void* allocate(::std::size_t size) noexcept(is_noexcept)
+        {
+            if(auto size_class{find_class(size)}; size_class != nullptr && size_class->head != nullptr) [[likely]]
+            {
+                ++hit_cnt;
+                auto block{size_class->head};
+                size_class->head = block->next;
+                return block;
+            }
+            ++miss_cnt;
+            return upstream_t::allocate(size);
+        }
+
+        /**
+         * @brief 分配一个type类型对象所需的空间
+         *
+         * @tparam type 要分配的类型
+         * @return 内存区域首指针
+         */
+        template <typename type>
+        inline static type* allocate() noexcept(is_noexcept)
+        {
+            return static_cast<type*>(allocate(sizeof(type)));
+        }
+
+        /**
+         * @brief 分配连续n个type类型对象所需的空间
+         *
+         * @tparam type 要分配的类型
+         * @param n 要分配的对象个数
+         * @return 内存区域首指针和可容纳对象数
+         */
+        template <typename type>
+        inline static ::SoC::allocation_result<type*> allocate(::std::size_t n) noexcept(is_noexcept)
+        {
+            return ::SoC::allocation_result<type*>{static_cast<type*>(allocate(sizeof(type) * n)), n};
+        }
+
+        /**
+         * @brief 释放ptr起连续size个字节的内存区域，放入对应大小的缓存
+         *
+         * @param ptr 内存区域首指针
+         * @param size 要释放的字节数，需要和分配时保持一致
+         */
+        inline static void deallocate(void* ptr, ::std::size_t size) noexcept(is_noexcept)
+        {
+            // 不足以存放链表指针的内存块不缓存
+            if(size >= sizeof(free_block)) [[likely]]
+            {
+                auto size_class{find_class(size)};
+                if(size_class == nullptr) { size_class = find_class(0); }
+                if(size_class != nullptr) [[likely]]
+                {
+                    size_class->size = size;
+                    size_class->head = ::new(ptr) free_block{size_class->head};
+                    return;
+                }
+            }
+            upstream_t::deallocate(ptr, size);
+        }
+
+        /**
+         * @brief 释放n个type类型对象占用的空间
+         *
+         * @tparam type 要释放的类型
+         * @param ptr 内存区域首指针
+         * @param n 要释放的对象个数
+         */
+        template <typename type>
+        inline static void deallocate(type* ptr, ::std::size_t n = 1) noexcept(is_noexcept)
+        {
+            deallocate(static_cast<void*>(ptr), sizeof(type) * n);
+        }
+
+        /**
+         * @brief 将所有缓存的内存块归还上游分配器
+         *
+         */
+        inline static void release() noexcept(is_noexcept)
+        {
+            for(auto&& size_class: classes)
+            {
+#pragma GCC unroll 0
+                while(size_class.head != nullptr)
+                {
+                    auto block{size_class.head};
+                    size_class.head = block->next;
+                    upstream_t::deallocate(static_cast<void*>(block), size_class.size);
+                }
+                size_class.size = 0;
+            }
+        }
+
+        /**
+         * @brief 获取命中缓存的分配次数
+         *
+         * @return 命中次数
+         */
+        [[nodiscard]] inline static ::std::size_t get_hit_cnt() noexcept { return hit_cnt; }
+
+        /**
+         * @brief 获取未命中缓存的分配次数
+         *
+         * @return 未命中次数
+         */
+        [[nodiscard]] inline static ::std::size_t get_miss_cnt() noexcept { return miss_cnt; }
+
+        /**
+         * @brief 清零命中和未命中次数
+         *
+         */
+        inline static void reset_counter() noexcept
+        {
+            hit_cnt = 0;
+            miss_cnt = 0;
+        }
+
+        /**
+         * @brief 比较两个分配器对象是否相同
+         *
+         * @param lhs 左操作数
+         * @param rhs 右操作数
+         * @return 分配器对象是否相同
+         */
+        constexpr inline friend bool operator== (frame_cache_allocator lhs [[maybe_unused]],
+                                                 frame_cache_allocator rhs [[maybe_unused]]) noexcept
+        {
+            return true;
+        }
+    };
+
+    /**
+     * @brief 单调分配器，在绑定的缓冲区中移动指针完成分配
+     *
+     * 释放操作不做任何事，通过reset或scope一次性回收所有分配，适用于解析一帧数据、执行一批子任务等
+     * 生命周期明确的场景。缓冲区可以是任意连续内存，也可以通过buffer_guard从上游分配器（如堆的整页）获取
+     * @tparam tag 用于区分不同单调分配器实例的标签类型
+     * @note 分配器状态为全局共享，不可在中断中使用
+     */
+    template <typename tag = void>
+    struct monotonic_arena_allocator
+    {
+    private:
+        /// 缓冲区首指针
+        constinit inline static ::std::byte* begin_ptr{};
+        /// 下一次分配的起始位置
+        constinit inline static ::std::byte* current_ptr{};
+        /// 缓冲区尾指针
+        constinit inline static ::std::byte* end_ptr{};
+
+        /**
+         * @brief 从当前位置按align对齐后分配size个字节
+         *
+         * @param size 要分配的字节数
+         * @param align 对齐要求，必须是2的幂
+         * @return 内存区域首指针
+         */
+        inline static void* allocate_aligned(::std::size_t size, ::std::size_t align) noexcept(::SoC::optional_noexcept)
+        {
+            using namespace ::std::string_view_literals;
+            auto address{reinterpret_cast<::std::uintptr_t>(current_ptr)};
+            auto offset{((address + align - 1) & ~(align - 1)) - address};
+            ::SoC::always_check(offset + size <= static_cast<::std::size_t>(end_ptr - current_ptr), "单调分配器剩余空间不足"sv);
+            auto result{current_ptr + offset};
+            current_ptr = result + size;
+            return result;
+        }
+
+    public:
+        /**
+         * @brief 绑定缓冲区并清空已有分配
+         *
+         * @param buffer 缓冲区
+         */
+        inline static void set_buffer(::std::span<::std::byte> buffer) noexcept
+        {
+            begin_ptr = buffer.data();
+            current_ptr = begin_ptr;
+            end_ptr = begin_ptr + buffer.size();
+        }
+
+        /**
+         * @brief 获取绑定的缓冲区
+         *
+         * @return 缓冲区
+         */
+        [[nodiscard]] inline static ::std::span<::std::byte> get_buffer() noexcept
+        {
+            return ::std::span{begin_ptr, end_ptr};
+        }
+
+        /**
+         * @brief 一次性回收所有分配
+         *
+         */
+        inline static void reset() noexcept { current_ptr = begin_ptr; }
+
+        /**
+         * @brief 获取已使用的字节数
+         *
+         * @return 已使用的字节数
+         */
+        [[nodiscard]] inline static ::std::size_t used() noexcept { return static_cast<::std::size_t>(current_ptr - begin_ptr); }
+
+        /**
+         * @brief 获取剩余的字节数
+         *
+         * @return 剩余的字节数
+         */
+        [[nodiscard]] inline static ::std::size_t remaining() noexcept
+        {
+            return static_cast<::std::size_t>(end_ptr - current_ptr);
+        }
+
+        /**
+         * @brief 分配size个字节，按std::max_align_t对齐
+         *
+         * @param size 要分配的字节数
+         * @return 内存区域首指针
+         */
+        inline static void* allocate(::std::size_t size) noexcept(::SoC::optional_noexcept)
+        {
+            return allocate_aligned(size, alignof(::std::max_align_t));
+        }
+
+        /**
+         * @brief 分配一个type类型对象所需的空间
+         *
+         * @tparam type 要分配的类型
+         * @return 内存区域首指针
+         */
+        template <typename type>
+        inline static type* allocate() noexcept(::SoC::optional_noexcept)
+        {
+            return static_cast<type*>(allocate_aligned(sizeof(type), alignof(type)));
+        }
+
+        /**
+         * @brief 分配连续n个type类型对象所需的空间
+         *
+         * @tparam type 要分配的类型
+         * @param n 要分配的对象个数
+         * @return 内存区域首指针和可容纳对象数
+         */
+        template <typename type>
+        inline static ::SoC::allocation_result<type*> allocate(::std::size_t n) noexcept(::SoC::optional_noexcept)
+        {
+            return ::SoC::allocation_result<type*>{static_cast<type*>(allocate_aligned(sizeof(type) * n, alignof(type))), n};
+        }
+
+        /**
+         * @brief 释放内存，单调分配器不逐个回收内存
+         *
+         * @param ptr 内存区域首指针
+         * @param n 要释放的对象个数
+         */
+        template <typename type>
+        inline static void deallocate(type* ptr [[maybe_unused]], ::std::size_t n [[maybe_unused]] = 1) noexcept
+        {
+        }
+
+        /**
+         * @brief 释放内存，单调分配器不逐个回收内存
+         *
+         * @param ptr 内存区域首指针
+         * @param size 要释放的字节数
+         */
+        inline static void deallocate(void* ptr [[maybe_unused]], ::std::size_t size [[maybe_unused]]) noexcept {}
+
+        /**
+         * @brief 比较两个分配器对象是否相同
+         *
+         * @param lhs 左操作数
+         * @param rhs 右操作数
+         * @return 分配器对象是否相同
+         */
+        constexpr inline friend bool operator== (monotonic_arena_allocator lhs [[maybe_unused]],
+                                                 monotonic_arena_allocator rhs [[maybe_unused]]) noexcept
+        {
+            return true;
+        }
+
+        /**
+         * @brief 分配作用域，析构时回收作用域内的所有分配，可以嵌套
+         *
+         */
+        struct scope
+        {
+        private:
+            /// 进入作用域时的分配位置
+            ::std::byte* saved_ptr{current_ptr};
+
+        public:
+            inline scope() noexcept = default;
+            scope(const scope&) = delete;
+            scope& operator= (const scope&) = delete;
+
+            inline ~scope() noexcept { current_ptr = saved_ptr; }
+        };
+
+        /**
+         * @brief 从上游分配器获取缓冲区并绑定到单调分配器，析构时归还缓冲区并恢复原缓冲区
+         *
+         * @tparam upstream_t 上游静态分配器类型，如SoC::ram_heap_allocator_t，大于一页时直接占用整页
+         */
+        template <::SoC::is_static_allocator upstream_t>
+        struct buffer_guard
+        {
+        private:
+            /// 从上游分配器获取的缓冲区
+            ::std::span<::std::byte> buffer;
+            /// 原缓冲区首指针
+            ::std::byte* saved_begin_ptr{begin_ptr};
+            /// 原分配位置
+            ::std::byte* saved_current_ptr{current_ptr};
+            /// 原缓冲区尾指针
+            ::std::byte* saved_end_ptr{end_ptr};
+
+        public:
+            /**
+             * @brief 从上游分配器获取size个字节作为缓冲区
+             *
+             * @param size 缓冲区大小
+             */
+            explicit inline buffer_guard(::std::size_t size) noexcept(::SoC::is_noexcept_allocator<upstream_t>) :
+                buffer{static_cast<::std::byte*>(upstream_t::allocate(size)), size}
+            {
+                set_buffer(buffer);
+            }
+
+            buffer_guard(const buffer_guard&) = delete;
+            buffer_guard& operator= (const buffer_guard&) = delete;
+
+            inline ~buffer_guard() noexcept
+            {
+                upstream_t::deallocate(static_cast<void*>(buffer.data()), buffer.size());
+                begin_ptr = saved_begin_ptr;
+                current_ptr = saved_current_ptr;
+                end_ptr = saved_end_ptr;
+            }
+        };
+    };
 }  // namespace SoC
@@ -0,0 +1,194 @@
+/**
+ * @file bip_buffer.cppm
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief 独立的双分区缓冲区实现
+ */
+
+export module SoC.freestanding:bip_buffer;
+import :utils;
+import :allocator;
+
+export namespace SoC
+{
+    namespace test
+    {
+        /// @see SoC::bip_buffer
+        extern "C++" template <typename type, ::std::size_t buffer_size, ::SoC::memory_capability capability_v>
+        struct bip_buffer;
+    }  // namespace test
+
+    /**
+     * @brief 双分区缓冲区(bip-buffer)，总是分配连续的区域，适用于变长报文的DMA收发
+     *
+     * 缓冲区中至多存在两个已提交分区：分区A位于缓冲区中部或末尾，分区B从缓冲区开头开始。
+     * 分区A末尾空间不足时在缓冲区开头开启分区B，因此预留区域和可读区域都不会跨越缓冲区末尾。
+     * 典型用法为reserve预留区域并写入，commit提交；读取时通过read获取连续区域，
+     * 交由usart_dma_stream::write发送，传输完成后通过release释放。
+     * 预留区域和可读区域均按缓冲区所在内存的访问能力标记，因此DMA能否访问在编译期检查
+     * @tparam type 元素类型，仅支持平凡可复制类型
+     * @tparam buffer_size 缓冲区容量
+     * @tparam capability_v 缓冲区对象所在内存的访问能力，放置在ccmram等仅CPU可访问的内存中时必须为cpu_only
+     */
+    template <typename type,
+              ::std::size_t buffer_size,
+              ::SoC::memory_capability capability_v = ::SoC::memory_capability::dma>
+        requires (::std::is_trivially_copyable_v<type> && buffer_size != 0)
+    struct bip_buffer
+    {
+        using value_type = type;
+        using size_type = ::std::size_t;
+        /// 可写区域类型
+        using write_region = ::SoC::memory_span<value_type, capability_v>;
+        /// 可读区域类型
+        using read_region = ::SoC::memory_span<const value_type, capability_v>;
+
+        /// 缓冲区所在内存的访问能力
+        constexpr inline static auto capability{capability_v};
+
+    private:
+        ::std::array<::SoC::union_wrapper<type>, buffer_size> buffer{};
+        /// 分区A的起始下标
+        ::std::size_t a_begin{};
+        /// 分区A的尾后下标
+        ::std::size_t a_end{};
+        /// 分区B的尾后下标，分区B总是从0开始，为0表示分区B为空
+        ::std::size_t b_end{};
+        /// 预留区域的起始下标
+        ::std::size_t reserve_begin{};
+        /// 预留区域的大小，为0表示没有预留区域
+        ::std::size_t reserve_size{};
+        friend struct ::SoC::test::bip_buffer<type, buffer_size, capability_v>;
+
+        /**
+         * @brief 获取缓冲区中下标为index的元素指针
+         *
+         * @param index 元素下标
+         * @return 元素指针
+         */
+        [[nodiscard]] constexpr inline auto* get_pointer(this auto&& self, ::std::size_t index) noexcept
+        {
+            return &self.buffer[index].value;
+        }
+
+    public:
+        /**
+         * @brief 构造一个空的双分区缓冲区
+         *
+         */
+        constexpr inline bip_buffer() noexcept = default;
+
+        bip_buffer(const bip_buffer&) = delete;
+        bip_buffer& operator= (const bip_buffer&) = delete;
+
+        /**
+         * @brief 获取缓冲区容量
+         *
+         * @return 缓冲区容量
+         */
+        [[nodiscard]] constexpr inline ::std::size_t capacity() const noexcept { return buffer_size; }
+
+        /**
+         * @brief 获取已提交的元素总数
+         *
+         * @return 已提交的元素总数
+         */
+        [[nodiscard]] constexpr inline ::std::size_t size() const noexcept { return a_end - a_begin + b_end; }
+
+        /**
+         * @brief 检查缓冲区中是否没有已提交的元素
+         *
+         * @return 缓冲区是否为空
+         */
+        [[nodiscard]] constexpr inline bool empty() const noexcept { return a_begin == a_end; }
+
+        /**
+         * @brief 预留n个连续的元素用于写入，新的预留会覆盖之前未提交的预留
+         *
+         * @param n 要预留的元素数
+         * @return 预留的区域，不存在足够大的连续区域时返回空区域
+         */
+        [[nodiscard]] constexpr inline write_region reserve(::std::size_t n) noexcept
+        {
+            reserve_size = 0;
+            if(n == 0) [[unlikely]] { return write_region{nullptr, 0}; }
+            if(b_end != 0)
+            {
+                // 分区B已开启时只能在分区B后写入，以保证先提交的元素先被读取
+                if(a_begin - b_end < n) { return write_region{nullptr, 0}; }
+                reserve_begin = b_end;
+            }
+            else if(buffer_size - a_end >= n) { reserve_begin = a_end; }
+            else if(a_begin >= n) { reserve_begin = 0; }
+            else
+            {
+                return write_region{nullptr, 0};
+            }
+            reserve_size = n;
+            return write_region{get_pointer(reserve_begin), n};
+        }
+
+        /**
+         * @brief 提交预留区域的前n个元素，未提交的部分被归还
+         *
+         * @param n 已写入的元素数
+         */
+        constexpr inline void commit(::std::size_t n) noexcept(::SoC::optional_noexcept)
+        {
+            using namespace ::std::string_view_literals;
+            ::SoC::always_check(n <= reserve_size, "提交的元素数超过预留区域"sv);
+            reserve_size = 0;
+            if(n == 0) { return; }
+            if(empty())
+            {
+                // 缓冲区为空时，包括预留后分区A被全部释放的情况，预留区域直接成为分区A
+                a_begin = reserve_begin;
+                a_end = reserve_begin + n;
+            }
+            else if(reserve_begin == a_end) { a_end += n; }
+            else
+            {
+                b_end += n;
+            }
+        }
+
+        /**
+         * @brief 获取最早提交的连续可读区域，即分区A
+         *
+         * @return 连续可读区域，缓冲区为空时为空区域
+         */
+        [[nodiscard]] constexpr inline read_region read() const noexcept
+        {
+            return read_region{get_pointer(a_begin), a_end - a_begin};
+        }
+
+        /**
+         * @brief 从可读区域头部释放n个元素，分区A被完全释放后分区B成为新的分区A
+         *
+         * @param n 已读取的元素数
+         */
+        constexpr inline void release(::std::size_t n) noexcept(::SoC::optional_noexcept)
+        {
+            using namespace ::std::string_view_literals;
+            ::SoC::always_check(n <= a_end - a_begin, "释放的元素数超过可读区域"sv);
+            a_begin += n;
+            if(a_begin == a_end)
+            {
+                a_begin = 0;
+                a_end = b_end;
+                b_end = 0;
+            }
+        }
+
+        /**
+         * @brief 清空缓冲区，同时放弃未提交的预留区域
+         *
+         */
+        constexpr inline void clear() noexcept
+        {
+            a_begin = 0;
+            a_end = 0;
+            b_end = 0;
+            reserve_size = 0;
+        }
+    };
+}  // namespace SoC
@@ -100,6 +100,10 @@ export namespace SoC
             ::std::errc error_code{};  // NOLINT(bugprone-invalid-enum-default-initialization)
             /// 协程调度优先级，越小优先级越高
             ::std::uint32_t priority{};
+            /// 协程的相对截止时刻，单位为系统时刻，0表示没有截止时刻，供最早截止时刻优先调度使用
+            ::std::uint32_t relative_deadline{};
+            /// 协程是否已分离，已分离的协程无人持有，执行完成后自行销毁协程帧
+            bool detached{};
             /// 调度器
             ::SoC::scheduler_base& scheduler;
             /// 当前协程退出后下一个要执行的协程柄
@@ -167,7 +171,10 @@ export namespace SoC
                     constexpr inline ::std::coroutine_handle<> await_suspend(::std::coroutine_handle<> handle) const noexcept
                     {
                         auto&& promise{::SoC::get_promise<promise_base_no_allocator>(handle)};
-                        return promise.handle_to_resume;
+                        auto handle_to_resume{promise.handle_to_resume};
+                        // 协程已挂起于最终挂起点，可以安全销毁协程帧
+                        if(promise.detached) { handle.destroy(); }
+                        return handle_to_resume;
                     }
 
                     /**
@@ -283,10 +290,12 @@ export namespace SoC
          *
          * @param ptr 要释放的内存指针
          */
-        constexpr inline static void operator delete (void* ptr) noexcept(::SoC::is_noexcept_allocator<allocator_type>)
+        constexpr inline static void operator delete (void* ptr) noexcept(::SoC::is_noexcept_allocator<allocator>)
         {
-            // 由于不支持 sized deallocation，所以这里传递 0 作为大小
-            allocator::deallocate(ptr, 0);
+            static_assert(::SoC::is_unsized_deallocate_allocator<allocator>,
+                          "不支持sized deallocation时，分配器需要提供static void deallocate(void*)以通过元数据获取块大小");
+            // 由于不支持 sized deallocation，所以需要分配器通过元数据获取大小，如SoC::heap_allocator_impl
+            allocator::deallocate(ptr);
         }
 #endif
     };
@@ -445,6 +454,24 @@ export namespace SoC
          */
         inline ::std::size_t get_priority() noexcept { return get_promise().priority; }
 
+        /**
+         * @brief 设置任务的相对截止时刻，任务每次就绪后需在此时间内被恢复执行
+         *
+         * @param deadline 相对截止时刻，对于周期任务通常等于其周期
+         */
+        inline void set_relative_deadline(::SoC::detail::is_duration auto deadline) noexcept
+        {
+            auto ticks{deadline.template duration_cast<::SoC::systick>().rep};
+            get_promise().relative_deadline = static_cast<::std::uint32_t>(ticks);
+        }
+
+        /**
+         * @brief 获取任务的相对截止时刻
+         *
+         * @return 相对截止时刻，单位为系统时刻
+         */
+        inline ::SoC::systick get_relative_deadline() noexcept { return ::SoC::systick{get_promise().relative_deadline}; }
+
         /**
          * @brief 等待子任务同步完成
          *
@@ -142,8 +142,10 @@ export namespace SoC
              */
             constexpr inline static void operator delete (void* ptr) noexcept(::SoC::is_noexcept_allocator<allocator_type>)
             {
-                // 由于不支持 sized deallocation，所以这里传递 0 作为大小
-                allocator_type{}.deallocate(ptr, 0);
+                static_assert(::SoC::is_unsized_deallocate_allocator<allocator_type>,
+                              "不支持sized deallocation时，分配器需要提供static void deallocate(void*)以通过元数据获取块大小");
+                // 由于不支持 sized deallocation，所以需要分配器通过元数据获取大小，如SoC::heap_allocator_impl
+                allocator_type{}.deallocate(ptr);
             }
 #endif
 
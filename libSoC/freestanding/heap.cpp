@@ -12,7 +12,9 @@ namespace SoC
 {
     using namespace ::std::string_view_literals;
 
-    ::SoC::heap::heap(::std::uintptr_t* begin, ::std::uintptr_t* end) noexcept(::SoC::optional_noexcept)
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::basic_heap(
+        ::std::uintptr_t* begin, ::std::uintptr_t* end) noexcept(::SoC::optional_noexcept)
     {
         // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
         if constexpr(::SoC::use_full_assert)
@@ -20,48 +22,192 @@ namespace SoC
             ::SoC::assert(reinterpret_cast<::std::uintptr_t>(end) % page_size == 0, "堆结束地址必须对齐到页边界"sv);
         }
         auto bytes{(end - begin) * ptr_size};
-        auto pages{bytes / (page_size + sizeof(::SoC::detail::heap_page_metadata))};
-        if constexpr(::SoC::use_full_assert) { ::SoC::assert(pages > 0, "堆大小必须大于一页"sv); }
-        auto* metadata_begin{::std::launder(reinterpret_cast<::SoC::detail::heap_page_metadata*>(begin))};
+        auto pages{bytes / (page_size + sizeof(page_metadata_t))};
+        auto get_bitmap_words{[](::std::size_t pages) static noexcept
+                              { return (pages + bitmap_word_bits - 1) / bitmap_word_bits; }};
+        // 为位图预留空间，位图按字分配，因此可能需要减少页数
+#pragma GCC unroll(0)
+        while(pages != 0 && pages * (page_size + sizeof(page_metadata_t)) +
+                                    bitmap_cnt * get_bitmap_words(pages) * sizeof(bitmap_word_t) >
+                                bytes)
+        {
+            --pages;
+        }
+        if constexpr(::SoC::use_full_assert)
+        {
+            ::SoC::assert(pages > 0, "堆大小必须大于一页"sv);
+            if constexpr(compact_metadata)
+            {
+                ::SoC::assert(pages < page_metadata_t::null_link, "使用紧凑页元数据时堆页数必须小于65535"sv);
+            }
+        }
+        auto* metadata_begin{::std::launder(reinterpret_cast<page_metadata_t*>(begin))};
         auto* metadata_end{metadata_begin + pages};
         metadata = ::std::span{metadata_begin, metadata_end};
 
-        auto ptr{reinterpret_cast<::std::uintptr_t>(metadata_end)};
+        // 位图区紧跟在元数据区之后，初始时所有位为0
+        bitmap_words = get_bitmap_words(pages);
+        bitmaps = reinterpret_cast<bitmap_word_t*>(metadata_end);
+        ::std::ranges::fill_n(bitmaps, bitmap_cnt * bitmap_words, 0);
+
+        auto ptr{reinterpret_cast<::std::uintptr_t>(bitmaps + (bitmap_cnt * bitmap_words))};
         ptr = (ptr + page_size - 1) & (-1zu << page_shift);
         data = reinterpret_cast<::SoC::detail::free_block_list_t*>(ptr);
 
-        // 将所有未初始化的内存视为空闲页进行划分，并穿成链表
+        // 将所有未初始化的内存视为空闲页，同时设置页空闲位图
 #pragma GCC unroll(2)
         for(auto&& page: metadata)
         {
-            auto* free_block_list{reinterpret_cast<::SoC::detail::free_block_list_t*>(ptr)};
-            ::new(&page)::SoC::detail::heap_page_metadata{&page + 1, free_block_list, 0, page_shift};
-            ::new(free_block_list)::SoC::detail::free_block_list_t{nullptr};
-            ptr += page_size;
+            ::new(&page)page_metadata_t{};
+            reset_free_page(page);
         }
-        metadata.back().next_page = nullptr;
 
-        // 空闲链表按块大小排序，最后一项为空闲页链表
-        // 将首个空闲页放入空闲页链表
-        free_page_list.back() = metadata.data();
+        // 按地址顺序将所有页划分为尽可能大的对齐页块，放入伙伴系统
+        for(auto page_index{0zu}; page_index != pages;)
+        {
+            auto order{::std::min({static_cast<::std::size_t>(::std::countr_zero(page_index)),
+                                   static_cast<::std::size_t>(::std::bit_width(pages - page_index)) - 1,
+                                   max_order})};
+            link_free_run(&metadata[page_index], order);
+            page_index += 1zu << order;
+        }
 
         // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
     }
 
-    ::SoC::detail::free_block_list_t* ::SoC::heap::make_block_in_page(::std::size_t free_list_index) noexcept(
-        ::SoC::optional_noexcept)
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    void ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::report_heap_full(
+        ::std::string_view message) noexcept(::SoC::optional_noexcept)
+    {
+        if constexpr(::SoC::is_build_mode(::SoC::build_mode::fuzzer))
+        {
+            // fuzzer模式下使用错误码退出，以便和其他断言失败进行区分
+            ::SoC::fuzzer_assert(false, fuzzer_error_code::heap_full);
+        }
+        else
+        {
+            ::SoC::always_check(false, message);
+        }
+    }
+
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    void ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::reset_free_page(
+        page_metadata_t& page_metadata) noexcept
+    {
+        auto&& [_, _, _, used_block, block_size_shift, order]{page_metadata};
+        set_next_page(page_metadata, nullptr);
+        set_prev_page(page_metadata, nullptr);
+        // 将空闲块指针指向数据区，对于页来说，完成了空闲链表的初始化
+        auto* page_begin{get_page_begin(&page_metadata)};
+        set_free_block_list(page_metadata, page_begin);
+        ::new(page_begin)::SoC::detail::free_block_list_t{nullptr};
+        used_block = 0;
+        block_size_shift = page_shift;
+        order = invalid_order;
+        set_bit(get_free_page_bitmap(), get_page_index(&page_metadata));
+    }
+
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    void ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::link_free_run(page_metadata_t* page_metadata,
+                                                                                            ::std::size_t order) noexcept
+    {
+        page_metadata->order = order;
+        link_page(free_run_list[order], page_metadata);
+    }
+
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    void ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::unlink_free_run(
+        page_metadata_t* page_metadata) noexcept
+    {
+        unlink_page(free_run_list[page_metadata->order], page_metadata);
+        page_metadata->order = invalid_order;
+    }
+
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    page_metadata_t* ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::pop_free_run(
+        ::std::size_t order) noexcept
+    {
+        // 寻找不小于order的最小非空阶
+        auto current_order{order};
+#pragma GCC unroll(0)
+        while(current_order <= max_order && free_run_list[current_order] == nullptr) { ++current_order; }
+        if(current_order > max_order) [[unlikely]] { return nullptr; }
+
+        auto* page_metadata{free_run_list[current_order]};
+        unlink_free_run(page_metadata);
+        // 逐级拆分，将后半部分作为伙伴归还
+#pragma GCC unroll(0)
+        while(current_order != order)
+        {
+            --current_order;
+            link_free_run(page_metadata + (1zu << current_order), current_order);
+        }
+        return page_metadata;
+    }
+
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    void ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::push_free_run(page_metadata_t* page_metadata,
+                                                                                            ::std::size_t order) noexcept
+    {
+        auto page_index{get_page_index(page_metadata)};
+        auto page_cnt{metadata.size()};
+#pragma GCC unroll(0)
+        while(order < max_order)
+        {
+            auto buddy_index{page_index ^ (1zu << order)};
+            // 伙伴超出堆范围，或不是同阶的空闲页块首页时停止合并
+            if(buddy_index + (1zu << order) > page_cnt || metadata[buddy_index].order != order) { break; }
+            unlink_free_run(&metadata[buddy_index]);
+            page_index &= ~(1zu << order);
+            ++order;
+        }
+        link_free_run(&metadata[page_index], order);
+    }
+
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    void ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::release_pages(::std::size_t page_index,
+                                                                                            ::std::size_t page_cnt) noexcept
+    {
+        for(auto&& page_metadata: metadata.subspan(page_index, page_cnt)) { reset_free_page(page_metadata); }
+#pragma GCC unroll(0)
+        while(page_cnt != 0)
+        {
+            // 首页地址对齐和剩余页数共同决定可归还的最大页块
+            auto order{::std::min({static_cast<::std::size_t>(::std::countr_zero(page_index)),
+                                   static_cast<::std::size_t>(::std::bit_width(page_cnt)) - 1,
+                                   max_order})};
+            push_free_run(&metadata[page_index], order);
+            page_index += 1zu << order;
+            page_cnt -= 1zu << order;
+        }
+    }
+
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    page_metadata_t* ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::acquire_free_run(
+        ::std::size_t order) noexcept(::SoC::optional_noexcept)
+    {
+        auto* page_metadata{pop_free_run(order)};
+        if(page_metadata == nullptr) [[unlikely]]
+        {
+            page_gc();
+            page_metadata = pop_free_run(order);
+            if(page_metadata == nullptr) { report_heap_full(order == 0 ? "剩余堆空间不足"sv : "堆中剩余连续分页数量不足"sv); }
+        }
+        return page_metadata;
+    }
+
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    ::SoC::detail::free_block_list_t* ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::make_block_in_page(
+        ::std::size_t free_list_index) noexcept(::SoC::optional_noexcept)
     {
         auto&& block_metadata_ptr{free_page_list[free_list_index]};
         if constexpr(::SoC::use_full_assert) { ::SoC::assert(block_metadata_ptr == nullptr, "仅在块空闲链表为空时调用此函数"sv); }
 
-        auto&& free_page_list_head{free_page_list.back()};
-        if(free_page_list_head == nullptr) [[unlikely]] { free_page_list_head = page_gc(true); }
-        // 空闲页元数据指针
-        auto* free_page_ptr{free_page_list_head};
+        // 从伙伴系统中取出一页
+        auto* free_page_ptr{acquire_free_run(0)};
+        if(free_page_ptr == nullptr) [[unlikely]] { return nullptr; }
         // 空闲页基址
-        auto* page_begin{free_page_ptr->free_block_list};
-        // 从空闲页表里取出一页
-        free_page_list_head = ::std::exchange(free_page_list_head->next_page, nullptr);
+        auto* page_begin{get_free_block_list(*free_page_ptr)};
 
         auto heap_block_size{1zu << (free_list_index + min_block_shift)};
         auto* page_ptr{page_begin};
@@ -90,160 +236,96 @@ namespace SoC
             // 最后一个块的next指针设为nullptr
             *(page_ptr - step) = ::SoC::detail::free_block_list_t{};
         }
-        // 从空闲链表里取出的页使用计数为0，不需要设置
-        block_metadata_ptr = free_page_ptr;
+        // 从伙伴系统里取出的页使用计数为0且已从链表中删除，不需要设置
+        // 取页时page_gc可能释放延迟释放链表中的块，使块空闲链表不再为空，因此插入链表头部而非直接赋值
+        link_page(block_metadata_ptr, free_page_ptr);
         // 设置块大小的左移量
         block_metadata_ptr->block_size_shift = free_list_index + min_block_shift;
+        // 页已分块但尚未使用，标记为空页
+        set_bit(get_empty_page_bitmap(free_list_index), get_page_index(free_page_ptr));
         return page_begin;
     }
 
-    ::SoC::detail::heap_page_metadata* ::SoC::heap::insert_block_into_page_list(
-        ::SoC::detail::heap_page_metadata* page_metadata) noexcept
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    void ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::insert_block_into_page_list(
+        page_metadata_t* page_metadata, ::std::size_t free_list_index) noexcept
     {
-        auto* old_head{::std::exchange(page_metadata, page_metadata->next_page)};
-        // 将空闲块指针指向数据区，对于页来说，完成了空闲链表的重新初始化
-        // 对于其他大小的块，需要使用make_block_in_page函数重新初始化空闲链表
-        old_head->free_block_list = ((old_head - metadata.data()) * page_size / ptr_size) + data;
-        ::new(old_head->free_block_list)::SoC::detail::free_block_list_t{nullptr};
-        auto* old_page_head{::std::exchange(free_page_list.back(), old_head)};
-        old_head->next_page = old_page_head;
-        // 初始化块大小的左移量为页大小左移量
-        old_head->block_size_shift = page_shift;
-        return page_metadata;
+        unlink_page(free_page_list[free_list_index], page_metadata);
+        reset_bit(get_empty_page_bitmap(free_list_index), get_page_index(page_metadata));
+        // 对于其他大小的块，再次分块时需要使用make_block_in_page函数重新初始化空闲链表
+        reset_free_page(*page_metadata);
+        push_free_run(page_metadata, 0);
     }
 
-    ::SoC::detail::heap_page_metadata* ::SoC::heap::page_gc(bool assert) noexcept(::SoC::optional_noexcept)
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    ::std::size_t(::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::page_gc)() noexcept(
+        ::SoC::optional_noexcept)
     {
+        if(deferred_list.load(::std::memory_order_relaxed) != nullptr) { drain_deferred_list(); }
+        auto reclaimed_cnt{0zu};
 #pragma GCC unroll(0)
-        for(auto&& block_list: ::std::span{free_page_list}.first(block_size_cnt - 1))
+        for(auto free_list_index{0zu}; free_list_index != free_page_list.size(); ++free_list_index)
         {
-            auto* block_list_cursor{block_list};
-            if(block_list_cursor == nullptr) { continue; }
-            // 删除除了第一个块以外的所有空闲块
-            for(auto* block_list_next{block_list_cursor->next_page}; block_list_next != nullptr;
-                block_list_next = block_list_cursor->next_page)
+            auto bitmap{get_empty_page_bitmap(free_list_index)};
+            for(auto word_index{0zu}; word_index != bitmap_words; ++word_index)
             {
-                if(block_list_next->used_block == 0)
-                {
-                    block_list_cursor->next_page = insert_block_into_page_list(block_list_next);
-                }
-                else
+                // insert_block_into_page_list会清除位图中对应的位，因此遍历该字的副本
+                for(auto word{bitmap[word_index]}; word != 0; word &= word - 1)
                 {
-                    block_list_cursor = block_list_next;
+                    auto page_index{(word_index * bitmap_word_bits) + static_cast<::std::size_t>(::std::countr_zero(word))};
+                    insert_block_into_page_list(&metadata[page_index], free_list_index);
+                    ++reclaimed_cnt;
                 }
             }
-            // 若第一个块也空闲，则插入到空闲页链表
-            if(block_list->used_block == 0) { block_list = insert_block_into_page_list(block_list); }
         }
-        auto* free_page{free_page_list.back()};
-        if(assert)
-        {
-            if constexpr(::SoC::is_build_mode(::SoC::build_mode::fuzzer))
-            {
-                ::SoC::fuzzer_assert(free_page != nullptr, fuzzer_error_code::heap_full);
-            }
-            else
-            {
-                ::SoC::always_check(free_page != nullptr, "剩余堆空间不足"sv);
-            }
-        }
-        return free_page;
+        statistics.record_page_gc(reclaimed_cnt);
+        return reclaimed_cnt;
     }
 
-    void* ::SoC::heap::remove_pages(::SoC::detail::free_block_list_t* range_begin,
-                                    ::SoC::detail::free_block_list_t* range_end) noexcept
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    void ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::drain_deferred_list() noexcept(
+        ::SoC::optional_noexcept)
     {
-        auto&& head{free_page_list.back()};
-        // 移除除了head外所有范围内的页
-        for(auto* ptr{head}; ptr->next_page != nullptr;)
-        {
-            auto* next_page{ptr->next_page};
-            if(auto* page_ptr{next_page->free_block_list}; page_ptr >= range_begin && page_ptr <= range_end)
-            {
-                next_page->used_block = 1;
-                next_page->free_block_list = nullptr;
-                ptr->next_page = next_page->next_page;
-            }
-            else
-            {
-                ptr = ptr->next_page;
-            }
-        }
-        // 若head也在范围内则删除
-        if(auto* page_ptr{head->free_block_list}; page_ptr >= range_begin && page_ptr <= range_end)
+        auto* block{deferred_list.exchange(nullptr, ::std::memory_order_acquire)};
+#pragma GCC unroll(0)
+        while(block != nullptr)
         {
-            head->used_block = 1;
-            head->free_block_list = nullptr;
-            head = head->next_page;
+            // 释放后块内容会被覆盖，因此先读取节点
+            auto [next, size]{*block};
+            deallocate(block, size);
+            block = next;
         }
-        return range_begin;
     }
 
-    void* ::SoC::heap::allocate_pages(::std::size_t page_cnt) noexcept(::SoC::optional_noexcept)
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    void* ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::allocate_pages(::std::size_t page_cnt) noexcept(
+        ::SoC::optional_noexcept)
     {
-        // 分配一个页的快速路径
-        if(page_cnt == 1) [[likely]]
+        // 不小于page_cnt的最小2的幂对应的阶数
+        auto order{static_cast<::std::size_t>(::std::bit_width(page_cnt - 1))};
+        auto* page_metadata{acquire_free_run(order)};
+        if(page_metadata == nullptr) [[unlikely]] { return nullptr; }
+
+        auto page_index{get_page_index(page_metadata)};
+        for(auto&& page: metadata.subspan(page_index, page_cnt))
         {
-            // 如果空闲页链表非空则已经通过快速路径完成分配
-            // 因此进入慢速路径一定需要调用page_gc
-            auto* free_page{page_gc(true)};
-            free_page_list.back() = free_page->next_page;
-            free_page->used_block = 1;
-            // 和快速路径保持一致，将空闲块指针设置为空
-            return ::std::exchange(free_page->free_block_list, nullptr);
+            page.used_block = 1;
+            set_free_block_list(page, nullptr);
+            reset_bit(get_free_page_bitmap(), get_page_index(&page));
         }
-        else
+        // 首页记录分配的末页，以便不带大小释放时获取页数
+        set_next_page(*page_metadata, page_metadata + page_cnt - 1);
+        // 页块中多余的页归还伙伴系统
+        if(auto rest_page_cnt{(1zu << order) - page_cnt}; rest_page_cnt != 0)
         {
-            page_gc(false);
-
-            for(auto metadata_ptr{metadata.begin()}, metadata_end{metadata.end()}; metadata_ptr != metadata_end;)
-            {
-                if(metadata_ptr->used_block == 0)
-                {
-                    auto continuous_page_cnt{1zu};
-                    // 闭区间[range_begin, range_end]表示连续页范围
-                    auto* range_begin = metadata_ptr->free_block_list;
-                    auto* range_end = metadata_ptr->free_block_list;
-                    // 向后搜索
-                    for(auto&& [_, free_block_list, used_block, _]: ::std::ranges::subrange{metadata_ptr + 1, metadata_end})
-                    {
-                        if(used_block == 0)
-                        {
-                            range_end = free_block_list;
-                            if(++continuous_page_cnt == page_cnt) { return remove_pages(range_begin, range_end); }
-                        }
-                        else
-                        {
-                            break;
-                        }
-                    }
-                    // 连续页范围占用的字节数
-                    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-                    auto delta{reinterpret_cast<::std::uintptr_t>(range_end) - reinterpret_cast<::std::uintptr_t>(range_begin)};
-                    // 转化为连续页数，由于是闭区间，因此+1
-                    auto advance{static_cast<::std::ptrdiff_t>(delta / page_size + 1)};
-                    metadata_ptr += advance;
-                }
-                else
-                {
-                    ++metadata_ptr;
-                }
-            }
-
-            if constexpr(::SoC::is_build_mode(::SoC::build_mode::fuzzer))
-            {
-                // fuzzer模式下下走异常路径退出，以便和正常分配进行区分
-                ::SoC::fuzzer_assert(false, fuzzer_error_code::heap_full);
-            }
-            else
-            {
-                ::SoC::always_check(false, "堆中剩余连续分页数量不足"sv);
-            }
-            return nullptr;
+            release_pages(page_index + page_cnt, rest_page_cnt);
         }
+        return get_page_begin(page_metadata);
     }
 
-    void ::SoC::heap::deallocate_pages(void* ptr, ::std::size_t actual_size) noexcept(::SoC::optional_noexcept)
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    void ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::deallocate_pages(
+        void* ptr, ::std::size_t actual_size) noexcept(::SoC::optional_noexcept)
     {
         auto page_cnt{static_cast<::std::ptrdiff_t>(actual_size / page_size)};
         if constexpr(::SoC::use_full_assert)
@@ -259,14 +341,10 @@ namespace SoC
                 ::SoC::assert(is_aligned, "释放范围首指针不满足页对齐"sv);
             }
         }
-        auto metadata_index{get_metadata_index(static_cast<::SoC::detail::free_block_list_t*>(ptr))};
-        auto&& head{free_page_list.back()};
-        constexpr auto scaled_page_size{page_size / sizeof(::SoC::detail::free_block_list_t)};
-        for(auto&& [index, metadata]:
-            ::std::views::zip(::std::views::iota(metadata_index), metadata.subspan(metadata_index, page_cnt)))
+        auto metadata_index{static_cast<::std::size_t>(get_metadata_index(static_cast<::SoC::detail::free_block_list_t*>(ptr)))};
+        if constexpr(::SoC::use_full_assert)
         {
-            auto&& [next_page, free_block_list, used_block, block_size_shift]{metadata};
-            if(::SoC::use_full_assert)
+            for(auto&& [_, _, _, used_block, block_size_shift, _]: metadata.subspan(metadata_index, page_cnt))
             {
                 if constexpr(::SoC::is_build_mode(::SoC::build_mode::fuzzer))
                 {
@@ -278,14 +356,37 @@ namespace SoC
                 }
                 ::SoC::assert(used_block == 1, "要释放的页使用计数不为1"sv);
             }
-            used_block = 0;
-            free_block_list = data + index * scaled_page_size;
-            ::new(free_block_list)::SoC::detail::free_block_list_t{nullptr};
-            next_page = ::std::exchange(head, &metadata);
         }
+        release_pages(metadata_index, page_cnt);
     }
 
-    void* ::SoC::heap::allocate_cold_path(::std::size_t actual_size) noexcept(::SoC::optional_noexcept)
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    ::std::size_t ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::get_allocated_size(
+        void* ptr) const noexcept(::SoC::optional_noexcept)
+    {
+        auto&& page_metadata{metadata[get_metadata_index(static_cast<::SoC::detail::free_block_list_t*>(ptr))]};
+        if(page_metadata.block_size_shift != page_shift) [[likely]] { return 1zu << page_metadata.block_size_shift; }
+
+        auto* last_page{get_next_page(page_metadata)};
+        if constexpr(::SoC::use_full_assert)
+        {
+            // 空闲页的使用计数为0，整页分配的非首页没有末页记录
+            auto is_first_page{page_metadata.used_block == 1 && last_page != nullptr && last_page >= &page_metadata};
+            if constexpr(::SoC::is_build_mode(::SoC::build_mode::fuzzer))
+            {
+                ::SoC::fuzzer_assert(is_first_page, fuzzer_error_code::block_size_mismatch);
+            }
+            else
+            {
+                ::SoC::assert(is_first_page, "指针不是整页分配的首页"sv);
+            }
+        }
+        return (get_page_index(last_page) - get_page_index(&page_metadata) + 1) * page_size;
+    }
+
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    void* ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::allocate_cold_path(
+        ::std::size_t actual_size) noexcept(::SoC::optional_noexcept)
     {
         if(actual_size >= page_size) { return allocate_pages(actual_size / page_size); }
         else
@@ -296,90 +397,278 @@ namespace SoC
             // 刚通过make_block_in_page生成的空闲块链表是连续的
             // 不使用next指针以减少一次内存访问
             auto&& free_list{free_page_list[free_page_list_index]};
-            free_list->free_block_list += step;
-            ++free_list->used_block;
+            set_free_block_list(*free_list, page_begin + step);
+            increase_used_block(*free_list, free_page_list_index);
             return page_begin;
         }
     }
 
-    ::std::size_t(::SoC::heap::get_free_pages)() const noexcept
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    ::std::size_t(::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::get_free_pages)() const noexcept
     {
         ::std::size_t cnt{};
 #pragma GCC unroll(4)
-        for(auto&& metadata: metadata)
+        for(auto word: get_free_page_bitmap()) { cnt += static_cast<::std::size_t>(::std::popcount(word)); }
+        return cnt;
+    }
+
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    ::std::size_t(::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::get_free_run_pages)() const noexcept
+    {
+        ::std::size_t cnt{};
+        for(auto order{0zu}; order != free_run_list.size(); ++order)
         {
-            if(metadata.used_block == 0) { ++cnt; }
+#pragma GCC unroll(0)
+            for(auto* page{free_run_list[order]}; page != nullptr; page = get_next_page(*page)) { cnt += 1zu << order; }
         }
         return cnt;
     }
 
-    void* ::SoC::heap::allocate(::std::size_t size) noexcept(::SoC::optional_noexcept)
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    ::std::size_t(::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::get_largest_free_run)() const noexcept
     {
+        auto largest_run{0zu};
+        auto current_run{0zu};
+#pragma GCC unroll(0)
+        for(auto page_index{0zu}; page_index < metadata.size();)
+        {
+            // 仅空闲页块的首页记录阶数，因此可以按页块跳过
+            if(auto order{metadata[page_index].order}; order != invalid_order)
+            {
+                current_run += 1zu << order;
+                page_index += 1zu << order;
+                largest_run = ::std::max(largest_run, current_run);
+            }
+            else
+            {
+                current_run = 0;
+                ++page_index;
+            }
+        }
+        return largest_run;
+    }
+
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    void* ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::allocate(::std::size_t size) noexcept(
+        ::SoC::optional_noexcept)
+    {
+        if(deferred_list.load(::std::memory_order_relaxed) != nullptr) [[unlikely]] { drain_deferred_list(); }
         auto actual_size{get_actual_allocate_size(size)};
         auto free_page_list_index{::std::countr_zero(actual_size) - min_block_shift};
-        if(actual_size <= page_size && free_page_list[free_page_list_index] != nullptr) [[likely]]
+        if(actual_size < page_size && free_page_list[free_page_list_index] != nullptr) [[likely]]
         {
             auto&& free_list{free_page_list[free_page_list_index]};
-            auto&& [next_page, free_block_list, used_block, _]{*free_list};
             // 由于空页会移除空闲链表，因此free_block_list不为nullptr
+            auto* free_block_list{get_free_block_list(*free_list)};
             void* result{free_block_list};
-            ++used_block;
+            increase_used_block(*free_list, free_page_list_index);
             free_block_list = free_block_list->next;
-            if(free_block_list == nullptr) [[unlikely]] { free_list = next_page; }
+            set_free_block_list(*free_list, free_block_list);
+            if(free_block_list == nullptr) [[unlikely]]
+            {
+                auto* next_page{get_next_page(*free_list)};
+                free_list = next_page;
+                if(next_page != nullptr) { set_prev_page(*next_page, nullptr); }
+            }
+            record_allocate(result, size, actual_size);
             return result;
         }
         else
         {
-            return allocate_cold_path(actual_size);
+            auto* result{allocate_cold_path(actual_size)};
+            // 分配失败时不计入统计
+            if(result != nullptr) [[likely]] { record_allocate(result, size, actual_size); }
+            return result;
         }
     }
 
-    void ::SoC::heap::deallocate(void* ptr, ::std::size_t size) noexcept(::SoC::optional_noexcept)
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    void ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::deallocate(void* ptr, ::std::size_t size) noexcept(
+        ::SoC::optional_noexcept)
     {
         auto* page_ptr{static_cast<::SoC::detail::free_block_list_t*>(ptr)};
         auto actual_size{get_actual_allocate_size(size)};
-        if(actual_size > page_size) [[unlikely]]
+        record_deallocate(ptr, size, actual_size);
+        if(actual_size >= page_size) [[unlikely]]
         {
             deallocate_pages(ptr, actual_size);
             return;
         }
         auto metadata_index{get_metadata_index(page_ptr)};
         auto&& metadata_ref{metadata[metadata_index]};
-        auto&& [next_page, free_block_list, used_block, block_size_shift]{metadata_ref};
+        auto&& [_, _, _, used_block, block_size_shift, _]{metadata_ref};
+        auto* old_head{get_free_block_list(metadata_ref)};
         if constexpr(::SoC::use_full_assert)
         {
-            // 输入正确性检查
-            auto block_size{1zu << block_size_shift};
-            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-            auto is_aligned{reinterpret_cast<::std::uintptr_t>(ptr) % block_size == 0};
-            if constexpr(::SoC::is_build_mode(::SoC::build_mode::fuzzer))
-            {
-                ::SoC::fuzzer_assert(block_size == actual_size, fuzzer_error_code::block_size_mismatch);
-                ::SoC::fuzzer_assert(is_aligned, fuzzer_error_code::pointer_unaligned);
-            }
-            else
-            {
-                ::SoC::assert(block_size == actual_size, "释放块大小与申请块大小不匹配"sv);
-                ::SoC::assert(is_aligned, "释放页指针不满足块对齐"sv);
-            }
+            check_deallocate_block(ptr, block_size_shift, actual_size);
 
             // 堆结构完整性检查
             auto max_block_num{1zu << (page_shift - block_size_shift)};
             ::SoC::assert(used_block >= 1 && used_block <= max_block_num,
                           "要释放的块所在页使用计数不在[1, max_block_num]范围内"sv);
-            ::SoC::assert(used_block != max_block_num || free_block_list == nullptr,
+            ::SoC::assert(used_block != max_block_num || old_head == nullptr,
                           "要释放的块所在页已完全分配，但其空闲块链表不为空"sv);
-            ::SoC::assert(used_block == max_block_num || free_block_list != nullptr,
+            ::SoC::assert(used_block == max_block_num || old_head != nullptr,
                           "要释放的块所在页未完全分配，但其空闲块链表为空"sv);
         }
-        auto* old_head{::std::exchange(free_block_list, page_ptr)};
+        set_free_block_list(metadata_ref, page_ptr);
         ::new(page_ptr)::SoC::detail::free_block_list_t{old_head};
-        --used_block;
+        auto free_page_list_index{static_cast<::std::size_t>(block_size_shift - min_block_shift)};
+        if(--used_block == 0) [[unlikely]]
+        {
+            // 页已空，标记到位图中以便page_gc回收
+            auto page_index{static_cast<::std::size_t>(metadata_index)};
+            set_bit(get_free_page_bitmap(), page_index);
+            set_bit(get_empty_page_bitmap(free_page_list_index), page_index);
+        }
         if(old_head == nullptr) [[unlikely]]
         {
             // 原先页是满的，不在空闲链表里，现在将其插入链表
-            auto free_page_list_index{block_size_shift - min_block_shift};
-            next_page = ::std::exchange(free_page_list[free_page_list_index], &metadata_ref);
+            link_page(free_page_list[free_page_list_index], &metadata_ref);
         }
     }
+
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    void ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::check_deallocate_block(
+        void* ptr, ::std::size_t block_size_shift, ::std::size_t actual_size) noexcept(::SoC::optional_noexcept)
+    {
+        auto block_size{1zu << block_size_shift};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto is_aligned{reinterpret_cast<::std::uintptr_t>(ptr) % block_size == 0};
+        if constexpr(::SoC::is_build_mode(::SoC::build_mode::fuzzer))
+        {
+            ::SoC::fuzzer_assert(block_size == actual_size, fuzzer_error_code::block_size_mismatch);
+            ::SoC::fuzzer_assert(is_aligned, fuzzer_error_code::pointer_unaligned);
+        }
+        else
+        {
+            ::SoC::assert(block_size == actual_size, "释放块大小与申请块大小不匹配"sv);
+            ::SoC::assert(is_aligned, "释放页指针不满足块对齐"sv);
+        }
+    }
+
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    ::std::size_t ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::allocate_batch(
+        ::std::size_t size, ::std::span<void*> result) noexcept(::SoC::optional_noexcept)
+    {
+        auto actual_size{get_actual_allocate_size(size)};
+        if(actual_size >= page_size) [[unlikely]]
+        {
+            // 整页分配没有可以批量取下的链表，逐个分配
+            for(auto i{0zu}; i != result.size(); ++i)
+            {
+                result[i] = allocate(size);
+                if(result[i] == nullptr) [[unlikely]] { return i; }
+            }
+            return result.size();
+        }
+
+        if(deferred_list.load(::std::memory_order_relaxed) != nullptr) [[unlikely]] { drain_deferred_list(); }
+        auto free_page_list_index{static_cast<::std::size_t>(::std::countr_zero(actual_size) - min_block_shift)};
+        auto&& free_list{free_page_list[free_page_list_index]};
+        auto allocated_cnt{0zu};
+#pragma GCC unroll(0)
+        while(allocated_cnt != result.size())
+        {
+            if(free_list == nullptr)
+            {
+                // 冷路径分块出新页并取走首块，剩余的块留在空闲链表中
+                auto* block{allocate_cold_path(actual_size)};
+                if(block == nullptr) [[unlikely]] { break; }
+                record_allocate(block, size, actual_size);
+                result[allocated_cnt++] = block;
+                continue;
+            }
+
+            // 从页的空闲块链表头部取下一段子链，页元数据只更新一次
+            auto&& page_metadata{*free_list};
+            auto* free_block_list{get_free_block_list(page_metadata)};
+            auto taken_cnt{0zu};
+#pragma GCC unroll(0)
+            while(free_block_list != nullptr && allocated_cnt != result.size())
+            {
+                record_allocate(free_block_list, size, actual_size);
+                result[allocated_cnt++] = free_block_list;
+                free_block_list = free_block_list->next;
+                ++taken_cnt;
+            }
+            if(page_metadata.used_block == 0) [[unlikely]]
+            {
+                auto page_index{get_page_index(&page_metadata)};
+                reset_bit(get_free_page_bitmap(), page_index);
+                reset_bit(get_empty_page_bitmap(free_page_list_index), page_index);
+            }
+            page_metadata.used_block = static_cast<decltype(page_metadata.used_block)>(page_metadata.used_block + taken_cnt);
+            set_free_block_list(page_metadata, free_block_list);
+            if(free_block_list == nullptr)
+            {
+                auto* next_page{get_next_page(page_metadata)};
+                free_list = next_page;
+                if(next_page != nullptr) { set_prev_page(*next_page, nullptr); }
+            }
+        }
+        return allocated_cnt;
+    }
+
+    template <::std::size_t min_block_shift_v, ::std::size_t page_shift_v, typename page_metadata_t>
+    void ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>::deallocate_batch(
+        ::std::span<void* const> ptrs, ::std::size_t size) noexcept(::SoC::optional_noexcept)
+    {
+        auto actual_size{get_actual_allocate_size(size)};
+        if(actual_size >= page_size) [[unlikely]]
+        {
+            for(auto* ptr: ptrs) { deallocate(ptr, size); }
+            return;
+        }
+
+        auto free_page_list_index{static_cast<::std::size_t>(::std::countr_zero(actual_size) - min_block_shift)};
+#pragma GCC unroll(0)
+        for(auto i{0zu}; i != ptrs.size();)
+        {
+            auto* first_block{static_cast<::SoC::detail::free_block_list_t*>(ptrs[i])};
+            auto metadata_index{get_metadata_index(first_block)};
+            auto&& metadata_ref{metadata[metadata_index]};
+            auto&& [_, _, _, used_block, block_size_shift, _]{metadata_ref};
+            auto* old_head{get_free_block_list(metadata_ref)};
+
+            // 将属于同一页的相邻块串成子链，子链尾部接上原空闲块链表
+            auto* last_block{first_block};
+            auto released_cnt{1zu};
+            if constexpr(::SoC::use_full_assert) { check_deallocate_block(first_block, block_size_shift, actual_size); }
+            record_deallocate(first_block, size, actual_size);
+#pragma GCC unroll(0)
+            for(++i; i != ptrs.size(); ++i)
+            {
+                auto* block{static_cast<::SoC::detail::free_block_list_t*>(ptrs[i])};
+                if(get_metadata_index(block) != metadata_index) { break; }
+                if constexpr(::SoC::use_full_assert) { check_deallocate_block(block, block_size_shift, actual_size); }
+                record_deallocate(block, size, actual_size);
+                ::new(last_block)::SoC::detail::free_block_list_t{block};
+                last_block = block;
+                ++released_cnt;
+            }
+            if constexpr(::SoC::use_full_assert)
+            {
+                ::SoC::assert(used_block >= released_cnt, "批量释放的块数超过所在页的使用计数"sv);
+            }
+            ::new(last_block)::SoC::detail::free_block_list_t{old_head};
+            set_free_block_list(metadata_ref, first_block);
+
+            used_block = static_cast<decltype(used_block)>(used_block - released_cnt);
+            if(used_block == 0)
+            {
+                // 页已空，标记到位图中以便page_gc回收
+                auto page_index{static_cast<::std::size_t>(metadata_index)};
+                set_bit(get_free_page_bitmap(), page_index);
+                set_bit(get_empty_page_bitmap(free_page_list_index), page_index);
+            }
+            // 原先页是满的，不在空闲链表里，现在将其插入链表
+            if(old_head == nullptr) { link_page(free_page_list[free_page_list_index], &metadata_ref); }
+        }
+    }
+
+    // 显式实例化SoC::heap、SoC::ccmram_heap和SoC::compact_heap，其他模板参数需要在此添加
+    template struct ::SoC::basic_heap<4, 9>;
+    template struct ::SoC::basic_heap<3, 10>;
+    template struct ::SoC::basic_heap<4, 9, ::SoC::detail::compact_heap_page_metadata>;
 }  // namespace SoC
@@ -12,6 +12,7 @@ module;
 #endif
 export module SoC.freestanding:heap;
 import :allocator;
+import :io;
 
 export namespace SoC
 {
@@ -28,19 +29,315 @@ export namespace SoC
         };
 
         /**
-         * @brief 堆页元数据
+         * @brief 延迟释放链表节点，存放在待释放块中
+         *
+         */
+        struct deferred_block_t
+        {
+            // 下一个待释放块
+            ::SoC::detail::deferred_block_t* next;
+            // 待释放块的大小
+            ::std::size_t size;
+        };
+
+        /**
+         * @brief 堆页元数据，ARM上每页16字节
          *
          */
         struct heap_page_metadata
         {
-            // 下一个空闲页的元数据指针
+            /// 伙伴系统的最大阶数
+            constexpr inline static ::std::size_t max_order{15};
+            /// 不是空闲页块首页的页的阶数
+            constexpr inline static ::std::uint8_t invalid_order{0xff};
+
+            // 下一个空闲页的元数据指针；整页分配时首页的该字段指向分配的末页
             ::SoC::detail::heap_page_metadata* next_page;
+            // 上一个空闲页的元数据指针
+            ::SoC::detail::heap_page_metadata* prev_page;
             // 页内空闲块链表的头指针
             ::SoC::detail::free_block_list_t* free_block_list;
             // 已使用块的数量
             ::std::uint16_t used_block;
             // 块大小的左移量
-            ::std::uint16_t block_size_shift;
+            ::std::uint8_t block_size_shift;
+            // 空闲页块的阶数，仅空闲页块的首页有效，其余页为SoC::basic_heap::invalid_order
+            ::std::uint8_t order;
+        };
+
+        /**
+         * @brief 紧凑堆页元数据，每页8字节
+         *
+         * 链表指针保存为页索引，空闲块链表头保存为相对页首的字节偏移量，均以null_link表示空。
+         * 要求堆不超过65535页、页不超过32KiB且每页不超过255块，读写链表时需要额外的地址换算
+         */
+        struct compact_heap_page_metadata
+        {
+            /// 伙伴系统的最大阶数，受4位阶数字段限制
+            constexpr inline static ::std::size_t max_order{14};
+            /// 不是空闲页块首页的页的阶数
+            constexpr inline static ::std::uint8_t invalid_order{0xf};
+            /// 表示空指针的链接值
+            constexpr inline static ::std::uint16_t null_link{0xffff};
+
+            // 下一个空闲页的索引；整页分配时首页的该字段为分配的末页索引
+            ::std::uint16_t next_page;
+            // 上一个空闲页的索引
+            ::std::uint16_t prev_page;
+            // 页内空闲块链表头相对页首的字节偏移量
+            ::std::uint16_t free_block_list;
+            // 已使用块的数量
+            ::std::uint8_t used_block;
+            // 块大小的左移量
+            ::std::uint8_t block_size_shift : 4;
+            // 空闲页块的阶数，仅空闲页块的首页有效，其余页为invalid_order
+            ::std::uint8_t order : 4;
+        };
+
+        /**
+         * @brief 未启用堆统计时使用的空统计信息，所有记录操作均为空操作
+         *
+         */
+        struct heap_no_statistics
+        {
+            constexpr inline static void record_allocate(::std::size_t size [[maybe_unused]],
+                                                         ::std::size_t actual_size [[maybe_unused]]) noexcept
+            {
+            }
+
+            constexpr inline static void record_deallocate(::std::size_t size [[maybe_unused]],
+                                                           ::std::size_t actual_size [[maybe_unused]]) noexcept
+            {
+            }
+
+            constexpr inline static void record_page_gc(::std::size_t reclaimed_cnt [[maybe_unused]]) noexcept {}
+        };
+
+        /**
+         * @brief 未启用堆跟踪时使用的空跟踪环，记录操作为空操作
+         *
+         */
+        struct heap_no_trace
+        {
+            constexpr inline static void record(::std::uintptr_t offset [[maybe_unused]],
+                                                ::std::size_t size [[maybe_unused]],
+                                                bool is_deallocate [[maybe_unused]]) noexcept
+            {
+            }
+        };
+    }  // namespace detail
+
+    /**
+     * @brief 堆统计信息，定义SOC_HEAP_STATISTICS时由堆记录，可通过SoC::println输出
+     *
+     * @tparam min_block_shift 最小块大小的左移量
+     * @tparam page_shift 页大小的左移量
+     */
+    template <::std::size_t min_block_shift, ::std::size_t page_shift>
+    struct heap_statistics
+    {
+        /// 大小类别数，依次为各块大小和整页分配
+        constexpr inline static auto size_class_cnt{page_shift - min_block_shift + 1};
+
+        using counter_t = ::std::array<::std::size_t, size_class_cnt>;
+
+        /// 各大小类别的分配次数
+        counter_t allocate_cnt{};
+        /// 各大小类别的释放次数
+        counter_t deallocate_cnt{};
+        /// 当前已分配块的申请字节数之和，不带大小释放的块按实际分配大小扣除，因此此时仅为近似值
+        ::std::size_t requested_bytes{};
+        /// 当前已分配块按实际分配大小计算的字节数之和
+        ::std::size_t actual_bytes{};
+        /// actual_bytes的历史最大值
+        ::std::size_t peak_actual_bytes{};
+        /// page_gc的调用次数
+        ::std::size_t page_gc_cnt{};
+        /// page_gc回收的页数之和
+        ::std::size_t reclaimed_pages{};
+        /// 伙伴系统中最长的连续空闲页数，获取统计信息时计算
+        ::std::size_t largest_free_run{};
+
+        /**
+         * @brief 获取实际分配大小对应的大小类别
+         *
+         * @param actual_size 实际分配的大小
+         * @return 大小类别索引
+         */
+        [[nodiscard]] constexpr inline static ::std::size_t get_size_class(::std::size_t actual_size) noexcept
+        {
+            if(actual_size >= (1zu << page_shift)) { return size_class_cnt - 1; }
+            return static_cast<::std::size_t>(::std::countr_zero(actual_size)) - min_block_shift;
+        }
+
+        /**
+         * @brief 记录一次分配
+         *
+         * @param size 申请的大小
+         * @param actual_size 实际分配的大小
+         */
+        constexpr inline void record_allocate(::std::size_t size, ::std::size_t actual_size) noexcept
+        {
+            ++allocate_cnt[get_size_class(actual_size)];
+            requested_bytes += size;
+            actual_bytes += actual_size;
+            peak_actual_bytes = ::std::max(peak_actual_bytes, actual_bytes);
+        }
+
+        /**
+         * @brief 记录一次释放
+         *
+         * @param size 申请的大小
+         * @param actual_size 实际分配的大小
+         */
+        constexpr inline void record_deallocate(::std::size_t size, ::std::size_t actual_size) noexcept
+        {
+            ++deallocate_cnt[get_size_class(actual_size)];
+            // 不带大小释放时按实际分配大小扣除，避免回绕
+            requested_bytes -= ::std::min(size, requested_bytes);
+            actual_bytes -= actual_size;
+        }
+
+        /**
+         * @brief 记录一次page_gc
+         *
+         * @param reclaimed_cnt 回收的页数
+         */
+        constexpr inline void record_page_gc(::std::size_t reclaimed_cnt) noexcept
+        {
+            ++page_gc_cnt;
+            reclaimed_pages += reclaimed_cnt;
+        }
+    };
+
+    template <::std::size_t min_block_shift, ::std::size_t page_shift>
+    constexpr inline ::std::size_t max_text_buffer_size<::SoC::heap_statistics<min_block_shift, page_shift>>{
+        ::SoC::max_text_buffer_size<::std::size_t>};
+
+    /**
+     * @brief 将堆统计信息输出到设备或文件
+     *
+     * @tparam output_t 输出设备或文件萃取器
+     * @param output 输出设备或文件萃取器
+     * @param statistics 堆统计信息
+     * @param tmp_buffer 输出缓冲区
+     */
+    template <typename output_t, ::std::size_t min_block_shift, ::std::size_t page_shift>
+        requires (::SoC::is_output_device<output_t, char> || ::std::same_as<::SoC::ofile_trait_t<char>, output_t>)
+    constexpr inline void do_print_arg(output_t& output,
+                                       const ::SoC::heap_statistics<min_block_shift, page_shift>& statistics,
+                                       ::SoC::unified_text_buffer tmp_buffer) noexcept
+    {
+        using namespace ::std::string_view_literals;
+        auto print_args{[&output, tmp_buffer](auto... args) constexpr noexcept
+                        { (::SoC::detail::do_print_arg_wrapper(output, args, tmp_buffer), ...); }};
+        print_args("已分配: 申请"sv,
+                   statistics.requested_bytes,
+                   "字节, 实际"sv,
+                   statistics.actual_bytes,
+                   "字节, 峰值"sv,
+                   statistics.peak_actual_bytes,
+                   "字节\npage_gc: "sv,
+                   statistics.page_gc_cnt,
+                   "次, 回收"sv,
+                   statistics.reclaimed_pages,
+                   "页, 最大连续空闲"sv,
+                   statistics.largest_free_run,
+                   "页"sv);
+        for(auto size_class{0zu}; size_class != statistics.size_class_cnt; ++size_class)
+        {
+            if(size_class != statistics.size_class_cnt - 1)
+            {
+                print_args("\n"sv, 1zu << (size_class + min_block_shift), "字节"sv);
+            }
+            else
+            {
+                print_args("\n整页"sv);
+            }
+            print_args(": 分配"sv,
+                       statistics.allocate_cnt[size_class],
+                       "次, 释放"sv,
+                       statistics.deallocate_cnt[size_class],
+                       "次"sv);
+        }
+    }
+
+    /**
+     * @brief 堆跟踪事件，转储时按内存布局直接写出
+     *
+     */
+    struct heap_trace_event
+    {
+        /// 释放事件在size中的标志位
+        constexpr inline static ::std::uint32_t deallocate_flag{1U << 31};
+
+        /// 事件发生时系统时刻的低32位
+        ::std::uint32_t systick;
+        /// 块首地址相对于堆数据区首地址的偏移量
+        ::std::uint32_t offset;
+        /// 申请的大小，释放事件带有deallocate_flag
+        ::std::uint32_t size;
+
+        /**
+         * @brief 判断是否为释放事件
+         *
+         * @return 是否为释放事件
+         */
+        [[nodiscard]] constexpr inline bool is_deallocate() const noexcept { return (size & deallocate_flag) != 0; }
+
+        /**
+         * @brief 获取申请的大小
+         *
+         * @return 申请的大小
+         */
+        [[nodiscard]] constexpr inline ::std::uint32_t get_size() const noexcept { return size & ~deallocate_flag; }
+    };
+
+    /**
+     * @brief 堆跟踪转储的头部，其后紧跟event_cnt个按时间顺序排列的SoC::heap_trace_event
+     *
+     */
+    struct heap_trace_header
+    {
+        /// 魔数，按小端序为"HTRC"
+        constexpr inline static ::std::uint32_t magic_value{0x4352'5448};
+
+        /// 魔数
+        ::std::uint32_t magic{magic_value};
+        /// 转储中的事件数
+        ::std::uint32_t event_cnt{};
+        /// 因环形缓冲区被覆盖而丢失的事件数
+        ::std::uint32_t dropped_cnt{};
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief 堆跟踪环，缓冲区写满后覆盖最早的事件
+         *
+         */
+        struct heap_trace_ring
+        {
+            /// 事件缓冲区，为空时不记录
+            ::std::span<::SoC::heap_trace_event> buffer{};
+            /// 已记录的事件总数
+            ::std::size_t event_cnt{};
+
+            /**
+             * @brief 记录一个事件
+             *
+             * @param offset 块首地址相对于堆数据区首地址的偏移量
+             * @param size 申请的大小
+             * @param is_deallocate 是否为释放事件
+             */
+            inline void record(::std::uintptr_t offset, ::std::size_t size, bool is_deallocate) noexcept
+            {
+                if(buffer.empty()) [[likely]] { return; }
+                buffer[event_cnt++ % buffer.size()] = ::SoC::heap_trace_event{
+                    static_cast<::std::uint32_t>(::SoC::get_systick()),
+                    static_cast<::std::uint32_t>(offset),
+                    static_cast<::std::uint32_t>(size) | (is_deallocate ? ::SoC::heap_trace_event::deallocate_flag : 0)};
+            }
         };
     }  // namespace detail
 
@@ -51,218 +348,1010 @@ export namespace SoC
     }  // namespace test
 
     /**
-     * @brief 基于空闲链表和slab的堆
+     * @brief 基于空闲链表和slab的堆，整页分配由伙伴系统管理
      *
+     * 块大小和页大小在编译期确定，大小类别的计算均可常量折叠
+     * @tparam min_block_shift_v 最小块大小的左移量
+     * @tparam page_shift_v 页大小的左移量
+     * @tparam page_metadata_t 页元数据类型，为SoC::detail::compact_heap_page_metadata时以地址换算为代价减小元数据区
+     * @note 成员函数在heap.cpp中实现，仅对其中显式实例化的模板参数可用
      */
-    struct heap
+    template <::std::size_t min_block_shift_v,
+              ::std::size_t page_shift_v,
+              typename page_metadata_t = ::SoC::detail::heap_page_metadata>
+    struct basic_heap
     {
     private:
         /// 测试接口
         friend struct ::SoC::test::heap;
 
+        /// 是否使用紧凑页元数据
+        constexpr inline static auto compact_metadata{::std::same_as<page_metadata_t, ::SoC::detail::compact_heap_page_metadata>};
+
+        static_assert((1zu << min_block_shift_v) >= sizeof(::SoC::detail::free_block_list_t), "最小块必须能容纳空闲块链表节点");
+        static_assert(min_block_shift_v < page_shift_v, "最小块必须小于页");
+        static_assert(page_shift_v - min_block_shift_v <
+                          ::std::numeric_limits<decltype(page_metadata_t::used_block)>::digits,
+                      "页内最小块数量必须能用页元数据中的使用计数表示");
+        static_assert(!compact_metadata || page_shift_v < 16, "紧凑页元数据要求页内偏移量和块大小的左移量能用16位和4位表示");
+
         /// 元数据区
-        ::std::span<::SoC::detail::heap_page_metadata> metadata;
+        ::std::span<page_metadata_t> metadata;
 
         /// 最小块大小的左移量
-        constexpr inline static auto min_block_shift{4zu};
+        constexpr inline static auto min_block_shift{min_block_shift_v};
+
+        /// 页大小的左移量
+        constexpr inline static auto page_shift{page_shift_v};
+
+        /// 块大小总数
+        constexpr inline static auto block_size_cnt{page_shift - min_block_shift + 1};
+
+        /// 伙伴系统的最大阶数，一个空闲页块最多包含2^max_order页
+        constexpr inline static auto max_order{page_metadata_t::max_order};
+
+        /// 不是空闲页块首页的页的阶数
+        constexpr inline static auto invalid_order{page_metadata_t::invalid_order};
+
+        using free_list_t = ::std::array<page_metadata_t*, block_size_cnt - 1>;
+
+        /// 块空闲链表，按块大小排序，不含页大小
+        free_list_t free_page_list{};
+
+        using free_run_list_t = ::std::array<page_metadata_t*, max_order + 1>;
+
+        /// 伙伴系统空闲链表，第k项为由2^k个连续空闲页组成的页块的双向链表
+        free_run_list_t free_run_list{};
+
+        /// 数据区
+        ::SoC::detail::free_block_list_t* data;
+
+        /// 位图的字类型
+        using bitmap_word_t = ::std::size_t;
+
+        /// 位图每个字的位数
+        constexpr inline static auto bitmap_word_bits{static_cast<::std::size_t>(::std::numeric_limits<bitmap_word_t>::digits)};
+
+        /// 位图总数，依次为页空闲位图和各块大小的空页位图
+        constexpr inline static auto bitmap_cnt{block_size_cnt};
+
+        /// 位图区，紧跟在元数据区之后
+        bitmap_word_t* bitmaps;
+
+        /// 每个位图的字数
+        ::std::size_t bitmap_words;
+
+        /// 延迟释放链表，中断中释放的块由此交给线程上下文批量释放
+        ::std::atomic<::SoC::detail::deferred_block_t*> deferred_list{};
+
+        /// 堆统计信息，未启用堆统计时为空
+        [[no_unique_address]] ::std::conditional_t<::SoC::use_heap_statistics,
+                                                   ::SoC::heap_statistics<min_block_shift, page_shift>,
+                                                   ::SoC::detail::heap_no_statistics> statistics{};
+
+        /// 堆跟踪环，未启用堆跟踪时为空
+        [[no_unique_address]] ::std::conditional_t<::SoC::use_heap_trace,
+                                                   ::SoC::detail::heap_trace_ring,
+                                                   ::SoC::detail::heap_no_trace> trace{};
+
+        /**
+         * @brief 记录一次成功的分配
+         *
+         * @param ptr 块起始地址
+         * @param size 申请的大小
+         * @param actual_size 实际分配的大小
+         */
+        [[using gnu: always_inline, artificial]] inline void
+            record_allocate(void* ptr, ::std::size_t size, ::std::size_t actual_size) noexcept
+        {
+            statistics.record_allocate(size, actual_size);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            trace.record(reinterpret_cast<::std::uintptr_t>(ptr) - reinterpret_cast<::std::uintptr_t>(data), size, false);
+        }
+
+        /**
+         * @brief 记录一次释放
+         *
+         * @param ptr 块起始地址
+         * @param size 申请的大小
+         * @param actual_size 实际分配的大小
+         */
+        [[using gnu: always_inline, artificial]] inline void
+            record_deallocate(void* ptr, ::std::size_t size, ::std::size_t actual_size) noexcept
+        {
+            statistics.record_deallocate(size, actual_size);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            trace.record(reinterpret_cast<::std::uintptr_t>(ptr) - reinterpret_cast<::std::uintptr_t>(data), size, true);
+        }
+
+        /**
+         * @brief 获取页空闲位图，第i位为1表示第i页的使用计数为0，不论是否分块
+         *
+         * @return 页空闲位图
+         */
+        [[using gnu: always_inline, artificial]] inline ::std::span<bitmap_word_t> get_free_page_bitmap() const noexcept
+        {
+            return ::std::span{bitmaps, bitmap_words};
+        }
+
+        /**
+         * @brief 获取已分块页的空页位图，第i位为1表示第i页已按该块大小分块且使用计数为0
+         *
+         * @param free_list_index 空闲链表索引
+         * @return 空页位图
+         */
+        [[using gnu: always_inline, artificial]] inline ::std::span<bitmap_word_t>
+            get_empty_page_bitmap(::std::size_t free_list_index) const noexcept
+        {
+            return ::std::span{bitmaps + ((free_list_index + 1) * bitmap_words), bitmap_words};
+        }
+
+        /**
+         * @brief 将位图中的第index位置1
+         *
+         * @param bitmap 位图
+         * @param index 位索引
+         */
+        [[using gnu: always_inline, artificial]] inline static void set_bit(::std::span<bitmap_word_t> bitmap,
+                                                                            ::std::size_t index) noexcept
+        {
+            bitmap[index / bitmap_word_bits] |= bitmap_word_t{1} << (index % bitmap_word_bits);
+        }
+
+        /**
+         * @brief 将位图中的第index位清0
+         *
+         * @param bitmap 位图
+         * @param index 位索引
+         */
+        [[using gnu: always_inline, artificial]] inline static void reset_bit(::std::span<bitmap_word_t> bitmap,
+                                                                              ::std::size_t index) noexcept
+        {
+            bitmap[index / bitmap_word_bits] &= ~(bitmap_word_t{1} << (index % bitmap_word_bits));
+        }
+
+        /**
+         * @brief 判断位图中的第index位是否为1
+         *
+         * @param bitmap 位图
+         * @param index 位索引
+         * @return 该位是否为1
+         */
+        [[using gnu: always_inline, artificial]] inline static bool test_bit(::std::span<const bitmap_word_t> bitmap,
+                                                                             ::std::size_t index) noexcept
+        {
+            return (bitmap[index / bitmap_word_bits] >> (index % bitmap_word_bits) & 1) != 0;
+        }
+
+        /**
+         * @brief 寻找一个空闲页并在其中划分出内存块，将其移除空闲页链表
+         *
+         * @param free_list_index 空闲链表索引
+         * @return 页起始地址
+         */
+        USE_VIRTUAL ::SoC::detail::free_block_list_t*
+            make_block_in_page(::std::size_t free_list_index) noexcept(::SoC::optional_noexcept);
+
+        /**
+         * @brief 将空闲的已分块页从块空闲链表中删除，归还伙伴系统
+         *
+         * @param page_metadata 页元数据指针
+         * @param free_list_index 空闲链表索引
+         */
+        USE_VIRTUAL void insert_block_into_page_list(page_metadata_t* page_metadata,
+                                                     ::std::size_t free_list_index) noexcept;
+
+        /**
+         * @brief 从空闲的已分块页中回收页到伙伴系统
+         *
+         * @return 回收的页数
+         * @note 通过空页位图查找空闲的已分块页，无需遍历块空闲链表
+         */
+        [[using gnu: noinline, cold]] USE_VIRTUAL ::std::size_t page_gc() noexcept(::SoC::optional_noexcept);
+
+        /**
+         * @brief 取出延迟释放链表中的所有块并逐一释放
+         *
+         */
+        [[using gnu: noinline, cold]] void drain_deferred_list() noexcept(::SoC::optional_noexcept);
+
+        /**
+         * @brief 获取页内指针所在页对应的元数据数组索引
+         *
+         * @param page_ptr 页内指针
+         * @return 元数据数组索引
+         */
+        [[using gnu: always_inline, hot]] USE_VIRTUAL inline ::std::ptrdiff_t
+            get_metadata_index(::SoC::detail::free_block_list_t* page_ptr) const noexcept(::SoC::optional_noexcept)
+        {
+            constexpr ::std::string_view message{"页指针超出当前堆范围"};
+            if constexpr(::SoC::use_full_assert) { ::SoC::assert(page_ptr >= data, message); }
+            auto page_index{static_cast<::std::ptrdiff_t>((page_ptr - data) * ptr_size / page_size)};
+            auto max_page_index{static_cast<::std::ptrdiff_t>(metadata.size())};
+            if constexpr(::SoC::use_full_assert) { ::SoC::assert(page_index < max_page_index, message); }
+            return page_index;
+        }
+
+        /**
+         * @brief 获取页元数据在元数据数组中的索引
+         *
+         * @param page_metadata 页元数据指针
+         * @return 元数据数组索引
+         */
+        [[using gnu: always_inline, artificial]] inline ::std::size_t
+            get_page_index(const page_metadata_t* page_metadata) const noexcept
+        {
+            return static_cast<::std::size_t>(page_metadata - metadata.data());
+        }
+
+        /**
+         * @brief 增加已分块页的使用计数，页由空变为非空时清除位图中对应的位
+         *
+         * @param page_metadata 页元数据
+         * @param free_list_index 空闲链表索引
+         */
+        [[using gnu: always_inline, hot]] inline void increase_used_block(page_metadata_t& page_metadata,
+                                                                          ::std::size_t free_list_index) noexcept
+        {
+            if(page_metadata.used_block++ == 0) [[unlikely]]
+            {
+                auto page_index{get_page_index(&page_metadata)};
+                reset_bit(get_free_page_bitmap(), page_index);
+                reset_bit(get_empty_page_bitmap(free_list_index), page_index);
+            }
+        }
+
+        /**
+         * @brief 获取页元数据对应的页首指针
+         *
+         * @param page_metadata 页元数据指针
+         * @return 页首指针
+         */
+        [[using gnu: always_inline, artificial]] inline ::SoC::detail::free_block_list_t*
+            get_page_begin(const page_metadata_t* page_metadata) const noexcept
+        {
+            return data + (page_metadata - metadata.data()) * (page_size / ptr_size);
+        }
+
+        /**
+         * @brief 将页元数据指针编码为页元数据中的链接
+         *
+         * @param page_metadata 页元数据指针，可以为nullptr
+         * @return 链接值
+         */
+        [[using gnu: always_inline, artificial]] inline auto encode_page_link(page_metadata_t* page_metadata) const noexcept
+        {
+            if constexpr(compact_metadata)
+            {
+                if(page_metadata == nullptr) { return page_metadata_t::null_link; }
+                return static_cast<::std::uint16_t>(get_page_index(page_metadata));
+            }
+            else
+            {
+                return page_metadata;
+            }
+        }
+
+        /**
+         * @brief 将页元数据中的链接解码为页元数据指针
+         *
+         * @param link 链接值
+         * @return 页元数据指针，可以为nullptr
+         */
+        [[using gnu: always_inline, artificial]] inline page_metadata_t*
+            decode_page_link(decltype(page_metadata_t::next_page) link) const noexcept
+        {
+            if constexpr(compact_metadata) { return link == page_metadata_t::null_link ? nullptr : metadata.data() + link; }
+            else
+            {
+                return link;
+            }
+        }
+
+        /**
+         * @brief 获取下一个空闲页
+         *
+         * @param page_metadata 页元数据
+         * @return 下一个空闲页的元数据指针
+         */
+        [[using gnu: always_inline, artificial]] inline page_metadata_t*
+            get_next_page(const page_metadata_t& page_metadata) const noexcept
+        {
+            return decode_page_link(page_metadata.next_page);
+        }
+
+        /**
+         * @brief 设置下一个空闲页
+         *
+         * @param page_metadata 页元数据
+         * @param next_page 下一个空闲页的元数据指针
+         */
+        [[using gnu: always_inline, artificial]] inline void set_next_page(page_metadata_t& page_metadata,
+                                                                           page_metadata_t* next_page) const noexcept
+        {
+            page_metadata.next_page = encode_page_link(next_page);
+        }
+
+        /**
+         * @brief 获取上一个空闲页
+         *
+         * @param page_metadata 页元数据
+         * @return 上一个空闲页的元数据指针
+         */
+        [[using gnu: always_inline, artificial]] inline page_metadata_t*
+            get_prev_page(const page_metadata_t& page_metadata) const noexcept
+        {
+            return decode_page_link(page_metadata.prev_page);
+        }
+
+        /**
+         * @brief 设置上一个空闲页
+         *
+         * @param page_metadata 页元数据
+         * @param prev_page 上一个空闲页的元数据指针
+         */
+        [[using gnu: always_inline, artificial]] inline void set_prev_page(page_metadata_t& page_metadata,
+                                                                           page_metadata_t* prev_page) const noexcept
+        {
+            page_metadata.prev_page = encode_page_link(prev_page);
+        }
+
+        /**
+         * @brief 获取页内空闲块链表的头指针
+         *
+         * @param page_metadata 页元数据
+         * @return 空闲块链表的头指针
+         */
+        [[using gnu: always_inline, artificial]] inline ::SoC::detail::free_block_list_t*
+            get_free_block_list(const page_metadata_t& page_metadata) const noexcept
+        {
+            if constexpr(compact_metadata)
+            {
+                auto offset{page_metadata.free_block_list};
+                if(offset == page_metadata_t::null_link) { return nullptr; }
+                return get_page_begin(&page_metadata) + (offset / ptr_size);
+            }
+            else
+            {
+                return page_metadata.free_block_list;
+            }
+        }
+
+        /**
+         * @brief 设置页内空闲块链表的头指针
+         *
+         * @param page_metadata 页元数据
+         * @param free_block_list 空闲块链表的头指针，必须位于该页内
+         */
+        [[using gnu: always_inline, artificial]] inline void
+            set_free_block_list(page_metadata_t& page_metadata, ::SoC::detail::free_block_list_t* free_block_list) const noexcept
+        {
+            if constexpr(compact_metadata)
+            {
+                page_metadata.free_block_list =
+                    free_block_list == nullptr
+                        ? page_metadata_t::null_link
+                        : static_cast<::std::uint16_t>((free_block_list - get_page_begin(&page_metadata)) * ptr_size);
+            }
+            else
+            {
+                page_metadata.free_block_list = free_block_list;
+            }
+        }
+
+        /**
+         * @brief 将页插入以head为头的双向链表头部
+         *
+         * @param head 链表头
+         * @param page_metadata 页元数据指针
+         */
+        [[using gnu: always_inline, artificial]] inline void link_page(page_metadata_t*& head,
+                                                                       page_metadata_t* page_metadata) noexcept
+        {
+            set_prev_page(*page_metadata, nullptr);
+            set_next_page(*page_metadata, head);
+            if(head != nullptr) { set_prev_page(*head, page_metadata); }
+            head = page_metadata;
+        }
+
+        /**
+         * @brief 将页从以head为头的双向链表中删除
+         *
+         * @param head 链表头
+         * @param page_metadata 页元数据指针
+         */
+        [[using gnu: always_inline, artificial]] inline void unlink_page(page_metadata_t*& head,
+                                                                         page_metadata_t* page_metadata) noexcept
+        {
+            auto* next_page{get_next_page(*page_metadata)};
+            auto* prev_page{get_prev_page(*page_metadata)};
+            if(prev_page == nullptr) { head = next_page; }
+            else
+            {
+                set_next_page(*prev_page, next_page);
+            }
+            if(next_page != nullptr) { set_prev_page(*next_page, prev_page); }
+            set_next_page(*page_metadata, nullptr);
+            set_prev_page(*page_metadata, nullptr);
+        }
+
+        /**
+         * @brief 将页元数据重置为未分块的空闲页
+         *
+         * @param page_metadata 页元数据
+         */
+        void reset_free_page(page_metadata_t& page_metadata) noexcept;
+
+        /**
+         * @brief 将空闲页块插入伙伴系统中对应阶数的空闲链表头部，不进行合并
+         *
+         * @param page_metadata 页块首页的元数据指针
+         * @param order 页块的阶数
+         */
+        void link_free_run(page_metadata_t* page_metadata, ::std::size_t order) noexcept;
+
+        /**
+         * @brief 将空闲页块从伙伴系统的空闲链表中删除
+         *
+         * @param page_metadata 页块首页的元数据指针
+         */
+        void unlink_free_run(page_metadata_t* page_metadata) noexcept;
+
+        /**
+         * @brief 从伙伴系统中取出一个阶数为order的空闲页块，必要时拆分更大的页块
+         *
+         * @param order 页块的阶数
+         * @return 页块首页的元数据指针，没有足够大的空闲页块时为nullptr
+         */
+        USE_VIRTUAL page_metadata_t* pop_free_run(::std::size_t order) noexcept;
+
+        /**
+         * @brief 将阶数为order的空闲页块归还伙伴系统，并逐级与空闲的伙伴合并
+         *
+         * @param page_metadata 页块首页的元数据指针
+         * @param order 页块的阶数
+         */
+        USE_VIRTUAL void push_free_run(page_metadata_t* page_metadata, ::std::size_t order) noexcept;
+
+        /**
+         * @brief 将从page_index开始的page_cnt个页重置为空闲页，并拆分为对齐的页块归还伙伴系统
+         *
+         * @param page_index 首页索引
+         * @param page_cnt 页数
+         */
+        void release_pages(::std::size_t page_index, ::std::size_t page_cnt) noexcept;
+
+        /**
+         * @brief 从伙伴系统中取出一个阶数为order的空闲页块，失败时回收空闲的已分块页后重试
+         *
+         * @param order 页块的阶数
+         * @return 页块首页的元数据指针
+         */
+        page_metadata_t* acquire_free_run(::std::size_t order) noexcept(::SoC::optional_noexcept);
+
+        /**
+         * @brief 分配一个或多个连续页，慢速路径
+         *
+         * @param page_cnt 要操作的页数量
+         * @note 从伙伴系统中取出不小于page_cnt页的最小页块，多余的页归还伙伴系统
+         */
+        USE_VIRTUAL void* allocate_pages(::std::size_t page_cnt) noexcept(::SoC::optional_noexcept);
+
+        /**
+         * @brief 释放一个或多个连续页，慢速路径
+         *
+         * @param ptr 块指针
+         * @param actual_size 要释放的大小
+         */
+        [[using gnu: noinline, cold]] USE_VIRTUAL void
+            deallocate_pages(void* ptr, ::std::size_t actual_size) noexcept(::SoC::optional_noexcept);
+
+        /**
+         * @brief 分配冷路径
+         *
+         * @param actual_size 要分配的大小
+         */
+        [[using gnu: noinline, cold]] USE_VIRTUAL void*
+            allocate_cold_path(::std::size_t actual_size) noexcept(::SoC::optional_noexcept);
+
+        /// 指针大小
+        constexpr inline static auto ptr_size{sizeof(void*)};
+
+        /**
+         * @brief 模糊测试错误码
+         *
+         */
+        enum class fuzzer_error_code : ::std::size_t  // NOLINT(performance-enum-size)
+        {
+            /// 成功，作为占位符
+            success,
+            /// 堆已满
+            heap_full,
+            /// 块大小不匹配
+            block_size_mismatch,
+            /// 指针未对齐
+            pointer_unaligned,
+        };
+
+        /**
+         * @brief 检查要释放的块的大小和对齐是否与所在页匹配，仅在启用完整断言时调用
+         *
+         * @param ptr 块起始地址
+         * @param block_size_shift 所在页的块大小左移量
+         * @param actual_size 按释放大小计算的实际分配大小
+         */
+        static void check_deallocate_block(void* ptr, ::std::size_t block_size_shift, ::std::size_t actual_size) noexcept(
+            ::SoC::optional_noexcept);
+
+        /**
+         * @brief 报告堆空间不足
+         *
+         * @param message 错误信息
+         */
+        [[using gnu: noinline, cold]] static void report_heap_full(::std::string_view message) noexcept(::SoC::optional_noexcept);
+
+    public:
+        /// 堆页大小
+        constexpr inline static auto page_size{1zu << page_shift};
+
+        /// 最小块大小
+        constexpr inline static auto min_block_size{1zu << min_block_shift};
+
+        /// 堆统计信息类型
+        using statistics_t = ::SoC::heap_statistics<min_block_shift, page_shift>;
+
+        /**
+         * @brief 初始化堆
+         *
+         * @param begin 堆起始地址
+         * @param end 堆结束地址
+         * @note end必须对齐到页边界
+         */
+        explicit basic_heap(::std::uintptr_t* begin, ::std::uintptr_t* end) noexcept(::SoC::optional_noexcept);
+
+        USE_VIRTUAL inline ~basic_heap() noexcept
+        {
+            // 防止覆盖率计算时，析构函数被优化掉
+            if constexpr(::SoC::is_build_mode(::SoC::build_mode::coverage))
+            {
+                ::std::atomic_signal_fence(::std::memory_order_relaxed);
+            }
+        }
+
+        inline basic_heap(const basic_heap&) noexcept = delete;
+        inline basic_heap& operator= (const basic_heap&) = delete;
+        inline basic_heap(basic_heap&&) noexcept = delete;
+        inline basic_heap& operator= (basic_heap&&) noexcept = delete;
+
+        /**
+         * @brief 获取实际分配的大小
+         *
+         * @param size 需要分配的大小
+         * @return 实际分配的大小
+         */
+        [[using gnu: always_inline, artificial, hot]] constexpr inline static ::std::size_t
+            get_actual_allocate_size(::std::size_t size) noexcept
+        {
+            auto ceiled_size{::std::max(::std::bit_ceil(size), min_block_size)};
+            // 不超过页大小时对齐到下一个2^N块边界
+            // 超过页大小时对齐到下一个页边界
+            return size > page_size ? (size + page_size - 1) / page_size * page_size : ceiled_size;
+        }
+
+        /**
+         * @brief 获取当前堆的总页数
+         *
+         * @return 总页数
+         */
+        [[nodiscard]] USE_VIRTUAL inline ::std::size_t get_total_pages() const noexcept { return metadata.size(); }
+
+        /**
+         * @brief 获取当前堆中空闲页数，不论是否分块
+         *
+         * @return 空闲页数
+         * @note 通过页空闲位图统计
+         */
+        [[nodiscard]] USE_VIRTUAL ::std::size_t get_free_pages() const noexcept;
+
+        /**
+         * @brief 获取当前堆中正在使用的页数，不论是否分块
+         *
+         * @return 正在使用的页数
+         */
+        [[nodiscard]] USE_VIRTUAL inline ::std::size_t get_using_pages() const noexcept
+        {
+            return get_total_pages() - get_free_pages();
+        }
+
+        /**
+         * @brief 获取伙伴系统中的空闲页数，不含尚未被page_gc回收的空闲已分块页
+         *
+         * @return 伙伴系统中的空闲页数
+         * @note 需要遍历伙伴系统空闲链表，仅用于诊断
+         */
+        [[nodiscard]] ::std::size_t get_free_run_pages() const noexcept;
 
-        /// 页大小的左移量
-        constexpr inline static auto page_shift{9zu};
+        /**
+         * @brief 获取伙伴系统中最长的连续空闲页数，相邻的空闲页块视为连续
+         *
+         * @return 最长的连续空闲页数
+         * @note 需要遍历元数据区，仅用于诊断
+         */
+        [[nodiscard]] ::std::size_t get_largest_free_run() const noexcept;
 
-        /// 块大小总数
-        constexpr inline static auto block_size_cnt{page_shift - min_block_shift + 1};
+        /**
+         * @brief 获取堆统计信息快照，仅在定义SOC_HEAP_STATISTICS时可用
+         *
+         * @return 堆统计信息
+         */
+        [[nodiscard]] inline statistics_t get_statistics(this const auto& self) noexcept
+            requires (::SoC::use_heap_statistics)
+        {
+            statistics_t result{self.statistics};
+            result.largest_free_run = self.get_largest_free_run();
+            return result;
+        }
 
-        using free_list_t = ::std::array<::SoC::detail::heap_page_metadata*, block_size_cnt>;
+        /**
+         * @brief 设置堆跟踪环的事件缓冲区并清空已记录的事件，仅在定义SOC_HEAP_TRACE时可用
+         *
+         * @param buffer 事件缓冲区，为空时停止记录
+         */
+        inline void set_trace_buffer(this auto& self, ::std::span<::SoC::heap_trace_event> buffer) noexcept
+            requires (::SoC::use_heap_trace)
+        {
+            self.trace = ::SoC::detail::heap_trace_ring{buffer};
+        }
 
-        /// 空闲链表
-        free_list_t free_page_list{};
+        /**
+         * @brief 将堆跟踪环中的事件按时间顺序转储到二进制文件，仅在定义SOC_HEAP_TRACE时可用
+         *
+         * 转储内容为SoC::heap_trace_header和其后的事件数组
+         * @tparam flush 转储结束后是否刷新缓冲区
+         * @param file 二进制输出文件
+         */
+        template <bool flush = false>
+        inline void dump_trace(this const auto& self, ::SoC::is_output_file auto& file) noexcept
+            requires (::SoC::use_heap_trace &&
+                      ::std::same_as<typename ::std::remove_cvref_t<decltype(file)>::value_type, ::std::byte>)
+        {
+            auto&& [buffer, event_cnt]{self.trace};
+            auto saved_cnt{::std::min(event_cnt, buffer.size())};
+            ::SoC::heap_trace_header header{.event_cnt = static_cast<::std::uint32_t>(saved_cnt),
+                                            .dropped_cnt = static_cast<::std::uint32_t>(event_cnt - saved_cnt)};
+            ::SoC::write_binary(file, ::std::as_bytes(::std::span{&header, 1}));
+            // 缓冲区被覆盖后，最早的事件位于下一个写入位置
+            auto oldest{event_cnt == saved_cnt ? 0zu : event_cnt % buffer.size()};
+            ::SoC::write_binary(file, ::std::as_bytes(buffer.subspan(oldest, saved_cnt - oldest)));
+            ::SoC::write_binary<flush>(file, ::std::as_bytes(buffer.first(oldest)));
+        }
 
-        /// 数据区
-        ::SoC::detail::free_block_list_t* data;
+        /**
+         * @brief 分配指定大小的块
+         *
+         * @param size 块大小
+         * @return void* 块起始地址
+         */
+        [[nodiscard]] USE_VIRTUAL void* allocate(::std::size_t size) noexcept(::SoC::optional_noexcept);
 
         /**
-         * @brief 寻找一个空闲页并在其中划分出内存块，将其移除空闲页链表
+         * @brief 获取按指定对齐分配时向allocate传递的大小
          *
-         * @param free_list_index 空闲链表索引
-         * @return 页起始地址
+         * 不超过页大小的块按自身大小对齐，因此将大小提升到对齐值即可，不必分配整页；整页分配总是按页对齐。
+         * 不超过页大小的块不会跨越页边界，因此也满足DMA突发传输不跨越1KiB边界的要求
+         * @param size 块大小
+         * @param alignment 对齐要求，必须是不超过页大小的2的幂
+         * @return 按对齐要求调整后的块大小
          */
-        USE_VIRTUAL ::SoC::detail::free_block_list_t*
-            make_block_in_page(::std::size_t free_list_index) noexcept(::SoC::optional_noexcept);
+        [[nodiscard]] constexpr inline static ::std::size_t
+            get_aligned_allocate_size(::std::size_t size, ::std::size_t alignment) noexcept(::SoC::optional_noexcept)
+        {
+            if constexpr(::SoC::use_full_assert)
+            {
+                using namespace ::std::string_view_literals;
+                ::SoC::assert(::std::has_single_bit(alignment) && alignment <= page_size, "对齐要求必须是不超过页大小的2的幂"sv);
+            }
+            return size > page_size ? size : ::std::max(size, alignment);
+        }
 
         /**
-         * @brief 将已分块的页从块空闲链表头部删除，插入页空闲链表头部
+         * @brief 分配指定大小且满足对齐要求的块
          *
-         * @param page 页元数据指针
-         * @return 下一个元数据的指针
+         * @param size 块大小
+         * @param alignment 对齐要求，必须是不超过页大小的2的幂
+         * @return void* 块起始地址
          */
-        USE_VIRTUAL ::SoC::detail::heap_page_metadata*
-            insert_block_into_page_list(::SoC::detail::heap_page_metadata* page_metadata) noexcept;
+        [[nodiscard]] inline void* allocate(::std::size_t size, ::std::size_t alignment) noexcept(::SoC::optional_noexcept)
+        {
+            return allocate(get_aligned_allocate_size(size, alignment));
+        }
 
         /**
-         * @brief 从空闲的已分块页中回收页到空闲页链表
+         * @brief 释放指定块
          *
-         * @param assert 是否断言空闲页链表非空
-         * @return 空闲页链表首指针
+         * @param ptr 块起始地址
+         * @param size 块大小
          */
-        [[using gnu: noinline, cold]] USE_VIRTUAL ::SoC::detail::heap_page_metadata*
-            page_gc(bool assert) noexcept(::SoC::optional_noexcept);
+        USE_VIRTUAL void deallocate(void* ptr, ::std::size_t size) noexcept(::SoC::optional_noexcept);
 
         /**
-         * @brief 获取页内指针所在页对应的元数据数组索引
+         * @brief 释放通过allocate(size, alignment)分配的块
          *
-         * @param page_ptr 页内指针
-         * @return 元数据数组索引
+         * @param ptr 块起始地址
+         * @param size 块大小
+         * @param alignment 分配时的对齐要求
          */
-        [[using gnu: always_inline, hot]] USE_VIRTUAL inline ::std::ptrdiff_t
-            get_metadata_index(::SoC::detail::free_block_list_t* page_ptr) const noexcept(::SoC::optional_noexcept)
+        inline void deallocate(void* ptr, ::std::size_t size, ::std::size_t alignment) noexcept(::SoC::optional_noexcept)
         {
-            constexpr ::std::string_view message{"页指针超出当前堆范围"};
-            if constexpr(::SoC::use_full_assert) { ::SoC::assert(page_ptr >= data, message); }
-            auto page_index{static_cast<::std::ptrdiff_t>((page_ptr - data) * ptr_size / page_size)};
-            auto max_page_index{static_cast<::std::ptrdiff_t>(metadata.size())};
-            if constexpr(::SoC::use_full_assert) { ::SoC::assert(page_index < max_page_index, message); }
-            return page_index;
+            deallocate(ptr, get_aligned_allocate_size(size, alignment));
         }
 
         /**
-         * @brief 从空闲页链表中删除范围[range_begin, range_end]内的页
+         * @brief 通过页元数据获取已分配块的实际大小，时间复杂度为O(1)
          *
-         * @param range_begin 页范围首指针
-         * @param range_end 页范围尾指针
-         * @return void* 页范围首指针
+         * @param ptr 块起始地址，整页分配时必须是分配的首页地址
+         * @return 块的实际分配大小
          */
-        USE_VIRTUAL void* remove_pages(::SoC::detail::free_block_list_t* range_begin,
-                                       ::SoC::detail::free_block_list_t* range_end) noexcept;
+        [[nodiscard]] ::std::size_t get_allocated_size(void* ptr) const noexcept(::SoC::optional_noexcept);
 
         /**
-         * @brief 分配一个或多个，慢速路径
+         * @brief 释放指定块，块大小通过页元数据获取
          *
-         * @param page_cnt 要操作的页数量
+         * 适用于不保存块大小的类型擦除所有者，如协程帧和basic_smart_function
+         * @param ptr 块起始地址
          */
-        USE_VIRTUAL void* allocate_pages(::std::size_t page_cnt) noexcept(::SoC::optional_noexcept);
+        inline void deallocate(void* ptr) noexcept(::SoC::optional_noexcept) { deallocate(ptr, get_allocated_size(ptr)); }
 
         /**
-         * @brief 释放一个或多个，慢速路径
+         * @brief 批量分配多个相同大小的块
          *
-         * @param ptr 块指针
-         * @param actual_size 要释放的大小
+         * 不超过页大小的块从同一页的空闲块链表中一次取下一段子链，页元数据和位图每页只更新一次
+         * @param size 块大小
+         * @param result 用于保存块起始地址的数组
+         * @return 成功分配的块数，堆空间不足时小于result.size()
          */
-        [[using gnu: noinline, cold]] USE_VIRTUAL void
-            deallocate_pages(void* ptr, ::std::size_t actual_size) noexcept(::SoC::optional_noexcept);
+        [[nodiscard]] ::std::size_t
+            allocate_batch(::std::size_t size, ::std::span<void*> result) noexcept(::SoC::optional_noexcept);
 
         /**
-         * @brief 分配冷路径
+         * @brief 批量释放多个相同大小的块
          *
-         * @param actual_size 要分配的大小
+         * 属于同一页的相邻块先串成子链，再一次接入页的空闲块链表，因此按地址排序的输入效果最好
+         * @param ptrs 块起始地址数组
+         * @param size 块大小
          */
-        [[using gnu: noinline, cold]] USE_VIRTUAL void*
-            allocate_cold_path(::std::size_t actual_size) noexcept(::SoC::optional_noexcept);
-
-        /// 指针大小
-        constexpr inline static auto ptr_size{sizeof(void*)};
+        void deallocate_batch(::std::span<void* const> ptrs, ::std::size_t size) noexcept(::SoC::optional_noexcept);
 
         /**
-         * @brief 模糊测试错误码
+         * @brief 延迟释放指定块，可在任意中断中调用
          *
+         * 块被压入无锁的多生产者单消费者链表，下次在线程上下文中调用allocate或page_gc时批量释放
+         * @param ptr 块起始地址
+         * @param size 块大小
+         * @note 仅在比较交换被同一链表的其他压入操作打断时重试，单核下重试次数不超过中断嵌套层数；
+         * 仅在最小块能容纳延迟释放链表节点时可用
          */
-        enum class fuzzer_error_code : ::std::size_t  // NOLINT(performance-enum-size)
+        inline void deferred_deallocate(void* ptr, ::std::size_t size) noexcept
+            requires (sizeof(::SoC::detail::deferred_block_t) <= min_block_size)
         {
-            /// 成功，作为占位符
-            success,
-            /// 堆已满
-            heap_full,
-            /// 块大小不匹配
-            block_size_mismatch,
-            /// 指针未对齐
-            pointer_unaligned,
-        };
+            auto* block{::new(ptr)::SoC::detail::deferred_block_t{deferred_list.load(::std::memory_order_relaxed), size}};
+#pragma GCC unroll(0)
+            while(!deferred_list.compare_exchange_weak(block->next,
+                                                       block,
+                                                       ::std::memory_order_release,
+                                                       ::std::memory_order_relaxed))
+            {
+            }
+        }
+    };
+
+    /// 默认几何参数的堆，最小块为16字节，页为512字节
+    using heap = ::SoC::basic_heap<4, 9>;
+
+    /// 适用于ccmram等仅供CPU访问的小容量内存的堆，最小块为8字节，页为1KiB
+    using ccmram_heap = ::SoC::basic_heap<3, 10>;
+
+    /// 使用紧凑页元数据的默认几何参数的堆，元数据区减半，链表操作需要额外的地址换算
+    using compact_heap = ::SoC::basic_heap<4, 9, ::SoC::detail::compact_heap_page_metadata>;
+
+    /**
+     * @brief 可在中断中使用的堆，分配和释放都在临界区中进行
+     *
+     * 堆的快速路径需要同时修改空闲块链表、使用计数和位图，无法通过单次比较交换完成，
+     * 因此通过SoC::critical_section_guard屏蔽中断，嵌入式下仅为两次BASEPRI读写
+     * @note 优先级高于临界区屏蔽优先级的中断仍不可使用该堆；通过全局分配器使用时，
+     * 分配器中的堆指针类型需要为对应的SoC::basic_interrupt_safe_heap*，如SoC::interrupt_safe_ram_heap_allocator_t
+     * @tparam min_block_shift_v 最小块大小的左移量
+     * @tparam page_shift_v 页大小的左移量
+     * @tparam page_metadata_t 页元数据类型
+     */
+    template <::std::size_t min_block_shift_v,
+              ::std::size_t page_shift_v,
+              typename page_metadata_t = ::SoC::detail::heap_page_metadata>
+    struct basic_interrupt_safe_heap : ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>
+    {
+    private:
+        using base_t = ::SoC::basic_heap<min_block_shift_v, page_shift_v, page_metadata_t>;
 
     public:
-        /// 堆页大小
-        constexpr inline static auto page_size{1zu << page_shift};
+        using base_t::base_t;
+        using typename base_t::statistics_t;
 
-        /// 最小块大小
-        constexpr inline static auto min_block_size{1zu << min_block_shift};
+        /**
+         * @brief 在临界区中获取当前堆中空闲页数，不论是否分块
+         *
+         * @return 空闲页数
+         */
+        [[nodiscard]] inline ::std::size_t get_free_pages() const noexcept
+        {
+            ::SoC::critical_section_guard guard{};
+            return base_t::get_free_pages();
+        }
 
         /**
-         * @brief 初始化堆
+         * @brief 在临界区中获取堆统计信息快照，仅在定义SOC_HEAP_STATISTICS时可用
          *
-         * @param begin 堆起始地址
-         * @param end 堆结束地址
-         * @note end必须对齐到页边界
+         * @return 堆统计信息
          */
-        explicit heap(::std::uintptr_t* begin, ::std::uintptr_t* end) noexcept(::SoC::optional_noexcept);
+        [[nodiscard]] inline statistics_t get_statistics(this const auto& self) noexcept
+            requires (::SoC::use_heap_statistics)
+        {
+            ::SoC::critical_section_guard guard{};
+            return self.base_t::get_statistics();
+        }
 
-        USE_VIRTUAL inline ~heap() noexcept
+        /**
+         * @brief 在临界区中获取伙伴系统中的空闲页数，不含尚未被page_gc回收的空闲已分块页
+         *
+         * @return 伙伴系统中的空闲页数
+         */
+        [[nodiscard]] inline ::std::size_t get_free_run_pages() const noexcept
         {
-            // 防止覆盖率计算时，析构函数被优化掉
-            if constexpr(::SoC::is_build_mode(::SoC::build_mode::coverage))
-            {
-                ::std::atomic_signal_fence(::std::memory_order_relaxed);
-            }
+            ::SoC::critical_section_guard guard{};
+            return base_t::get_free_run_pages();
         }
 
-        inline heap(const heap&) noexcept = delete;
-        inline heap& operator= (const heap&) = delete;
-        inline heap(heap&&) noexcept = delete;
-        inline heap& operator= (heap&&) noexcept = delete;
+        /**
+         * @brief 在临界区中获取伙伴系统中最长的连续空闲页数，相邻的空闲页块视为连续
+         *
+         * @return 最长的连续空闲页数
+         * @note 需要遍历元数据区，临界区长度随总页数增长，仅用于诊断
+         */
+        [[nodiscard]] inline ::std::size_t get_largest_free_run() const noexcept
+        {
+            ::SoC::critical_section_guard guard{};
+            return base_t::get_largest_free_run();
+        }
 
         /**
-         * @brief 获取实际分配的大小
+         * @brief 在临界区中通过页元数据获取已分配块的实际大小
          *
-         * @param size 需要分配的大小
-         * @return 实际分配的大小
+         * @param ptr 块起始地址，整页分配时必须是分配的首页地址
+         * @return 块的实际分配大小
          */
-        [[using gnu: always_inline, artificial, hot]] constexpr inline static ::std::size_t
-            get_actual_allocate_size(::std::size_t size) noexcept
+        [[nodiscard]] inline ::std::size_t get_allocated_size(void* ptr) const noexcept(::SoC::optional_noexcept)
         {
-            auto ceiled_size{::std::max(::std::bit_ceil(size), min_block_size)};
-            // 不超过页大小时对齐到下一个2^N块边界
-            // 超过页大小时对齐到下一个页边界
-            return size > page_size ? (size + page_size - 1) / page_size * page_size : ceiled_size;
+            ::SoC::critical_section_guard guard{};
+            return base_t::get_allocated_size(ptr);
         }
 
         /**
-         * @brief 获取当前堆的总页数
+         * @brief 在临界区中设置堆跟踪环的事件缓冲区并清空已记录的事件，仅在定义SOC_HEAP_TRACE时可用
          *
-         * @return 总页数
+         * @param buffer 事件缓冲区，为空时停止记录
          */
-        [[nodiscard]] USE_VIRTUAL inline ::std::size_t get_total_pages() const noexcept { return metadata.size(); }
+        inline void set_trace_buffer(::std::span<::SoC::heap_trace_event> buffer) noexcept
+            requires (::SoC::use_heap_trace)
+        {
+            ::SoC::critical_section_guard guard{};
+            base_t::set_trace_buffer(buffer);
+        }
 
         /**
-         * @brief 获取当前堆中空闲页数，不论是否分块
+         * @brief 在临界区中将堆跟踪环中的事件按时间顺序转储到二进制文件，仅在定义SOC_HEAP_TRACE时可用
          *
-         * @return 空闲页数
+         * @tparam flush 转储结束后是否刷新缓冲区
+         * @param file 二进制输出文件
+         * @note 转储期间中断被屏蔽，file的写入和刷新不能依赖被屏蔽的中断，必要时先转储到内存中的文件
          */
-        [[nodiscard]] USE_VIRTUAL ::std::size_t get_free_pages() const noexcept;
+        template <bool flush = false>
+        inline void dump_trace(::SoC::is_output_file auto& file) const noexcept
+            requires (::SoC::use_heap_trace &&
+                      ::std::same_as<typename ::std::remove_cvref_t<decltype(file)>::value_type, ::std::byte>)
+        {
+            ::SoC::critical_section_guard guard{};
+            base_t::template dump_trace<flush>(file);
+        }
 
         /**
-         * @brief 获取当前堆中正在使用的页数，不论是否分块
+         * @brief 在临界区中分配指定大小的块
          *
-         * @return 正在使用的页数
+         * @param size 块大小
+         * @return void* 块起始地址
          */
-        [[nodiscard]] USE_VIRTUAL inline ::std::size_t get_using_pages() const noexcept
+        [[nodiscard]] inline void* allocate(::std::size_t size) noexcept(::SoC::optional_noexcept)
         {
-            return get_total_pages() - get_free_pages();
+            ::SoC::critical_section_guard guard{};
+            return base_t::allocate(size);
         }
 
         /**
-         * @brief 分配指定大小的块
+         * @brief 在临界区中分配指定大小且满足对齐要求的块
          *
          * @param size 块大小
+         * @param alignment 对齐要求，必须是不超过页大小的2的幂
          * @return void* 块起始地址
          */
-        [[nodiscard]] USE_VIRTUAL void* allocate(::std::size_t size) noexcept(::SoC::optional_noexcept);
+        [[nodiscard]] inline void* allocate(::std::size_t size, ::std::size_t alignment) noexcept(::SoC::optional_noexcept)
+        {
+            return allocate(base_t::get_aligned_allocate_size(size, alignment));
+        }
 
         /**
-         * @brief 释放指定块
+         * @brief 在临界区中释放指定块
          *
          * @param ptr 块起始地址
          * @param size 块大小
          */
-        USE_VIRTUAL void deallocate(void* ptr, ::std::size_t size) noexcept(::SoC::optional_noexcept);
+        inline void deallocate(void* ptr, ::std::size_t size) noexcept(::SoC::optional_noexcept)
+        {
+            ::SoC::critical_section_guard guard{};
+            base_t::deallocate(ptr, size);
+        }
+
+        /**
+         * @brief 在临界区中释放通过allocate(size, alignment)分配的块
+         *
+         * @param ptr 块起始地址
+         * @param size 块大小
+         * @param alignment 分配时的对齐要求
+         */
+        inline void deallocate(void* ptr, ::std::size_t size, ::std::size_t alignment) noexcept(::SoC::optional_noexcept)
+        {
+            deallocate(ptr, base_t::get_aligned_allocate_size(size, alignment));
+        }
+
+        /**
+         * @brief 在临界区中释放指定块，块大小通过页元数据获取
+         *
+         * @param ptr 块起始地址
+         */
+        inline void deallocate(void* ptr) noexcept(::SoC::optional_noexcept)
+        {
+            ::SoC::critical_section_guard guard{};
+            base_t::deallocate(ptr);
+        }
+
+        /**
+         * @brief 在临界区中批量分配多个相同大小的块，临界区长度随块数增长
+         *
+         * @param size 块大小
+         * @param result 用于保存块起始地址的数组
+         * @return 成功分配的块数
+         */
+        [[nodiscard]] inline ::std::size_t allocate_batch(::std::size_t size, ::std::span<void*> result) noexcept(
+            ::SoC::optional_noexcept)
+        {
+            ::SoC::critical_section_guard guard{};
+            return base_t::allocate_batch(size, result);
+        }
+
+        /**
+         * @brief 在临界区中批量释放多个相同大小的块，临界区长度随块数增长
+         *
+         * @param ptrs 块起始地址数组
+         * @param size 块大小
+         */
+        inline void deallocate_batch(::std::span<void* const> ptrs, ::std::size_t size) noexcept(::SoC::optional_noexcept)
+        {
+            ::SoC::critical_section_guard guard{};
+            base_t::deallocate_batch(ptrs, size);
+        }
     };
 
+    /// 默认几何参数的可在中断中使用的堆
+    using interrupt_safe_heap = ::SoC::basic_interrupt_safe_heap<4, 9>;
+
     namespace detail
     {
         /**
@@ -270,16 +1359,18 @@ export namespace SoC
          * - type不为void
          * - type的对齐不超过堆的页大小
          * @tparam type 要判断的类型
+         * @tparam heap_t 堆类型
          */
-        template <typename type>
-        concept is_known_type_allocatable = !::std::is_void_v<type> && alignof(type) <= ::SoC::heap::page_size;
+        template <typename type, typename heap_t>
+        concept is_known_type_allocatable = !::std::is_void_v<type> && alignof(type) <= heap_t::page_size;
 
         /**
          * @brief 堆分配器实现，通过CRTP使用，要求满足：
-         * - static SoC::heap* wrapper::heap
+         * - static heap_t* wrapper::heap
          * @tparam wrapper 堆分配器类型
+         * @tparam heap_t 堆类型
          */
-        template <typename wrapper>
+        template <typename wrapper, typename heap_t = ::SoC::heap>
         struct heap_allocator_impl
         {
         private:
@@ -304,7 +1395,7 @@ export namespace SoC
              * @tparam type 要分配的类型
              * @return 内存区域首指针
              */
-            template <::SoC::detail::is_known_type_allocatable type>
+            template <::SoC::detail::is_known_type_allocatable<heap_t> type>
             inline static type* allocate() noexcept(::SoC::optional_noexcept)
             {
                 constexpr auto size{::std::max(sizeof(type), alignof(type))};
@@ -318,18 +1409,48 @@ export namespace SoC
              * @param n 要分配的对象个数
              * @return SoC::allocation_result<type*> 内存区域首指针和实际可容纳对象数
              */
-            template <::SoC::detail::is_known_type_allocatable type>
+            template <::SoC::detail::is_known_type_allocatable<heap_t> type>
             inline static ::SoC::allocation_result<type*> allocate(::std::size_t n) noexcept(::SoC::optional_noexcept)
             {
                 // sizeof(type) >= alignof(type)，天然保证对齐
                 constexpr auto size{sizeof(type)};
                 auto total_size{size * n};
                 // 获取实际分配的大小
-                auto actual_size{::SoC::heap::get_actual_allocate_size(total_size)};
+                auto actual_size{heap_t::get_actual_allocate_size(total_size)};
                 return ::SoC::allocation_result<type*>{static_cast<type*>(wrapper::heap->allocate(total_size)),
                                                        actual_size / size};
             }
 
+            /**
+             * @brief 分配至少size个字节且满足对齐要求的内存区域
+             *
+             * @param size 要分配的字节数
+             * @param alignment 对齐要求，必须是不超过页大小的2的幂
+             * @return 内存区域首指针
+             */
+            inline static void* allocate(::std::size_t size, ::std::size_t alignment) noexcept(::SoC::optional_noexcept)
+            {
+                return wrapper::heap->allocate(size, alignment);
+            }
+
+            /**
+             * @brief 分配至少连续n个type类型对象所需且满足对齐要求的空间，如DMA突发传输缓冲区
+             *
+             * @tparam type 要分配的类型
+             * @param n 要分配的对象个数
+             * @param alignment 对齐要求，必须是不超过页大小的2的幂
+             * @return SoC::allocation_result<type*> 内存区域首指针和实际可容纳对象数
+             */
+            template <::SoC::detail::is_known_type_allocatable<heap_t> type>
+            inline static ::SoC::allocation_result<type*> allocate(::std::size_t n, ::std::size_t alignment) noexcept(
+                ::SoC::optional_noexcept)
+            {
+                auto total_size{heap_t::get_aligned_allocate_size(sizeof(type) * n, ::std::max(alignment, alignof(type)))};
+                auto actual_size{heap_t::get_actual_allocate_size(total_size)};
+                return ::SoC::allocation_result<type*>{static_cast<type*>(wrapper::heap->allocate(total_size)),
+                                                       actual_size / sizeof(type)};
+            }
+
             /**
              * @brief 释放n个type类型对象占用的空间
              *
@@ -337,7 +1458,7 @@ export namespace SoC
              * @param ptr 内存区域首指针
              * @param n 要释放的对象个数
              */
-            template <::SoC::detail::is_known_type_allocatable type>
+            template <::SoC::detail::is_known_type_allocatable<heap_t> type>
             inline static void deallocate(type* ptr, ::std::size_t n = 1) noexcept(::SoC::optional_noexcept)
             {
                 wrapper::heap->deallocate(ptr, sizeof(type) * n);
@@ -354,6 +1475,40 @@ export namespace SoC
                 wrapper::heap->deallocate(ptr, size);
             }
 
+            /**
+             * @brief 释放ptr处的内存区域，大小通过页元数据获取
+             *
+             * @param ptr 内存区域首指针
+             */
+            inline static void deallocate(void* ptr) noexcept(::SoC::optional_noexcept) { wrapper::heap->deallocate(ptr); }
+
+            /**
+             * @brief 释放通过对齐分配得到的n个type类型对象占用的空间
+             *
+             * @tparam type 要释放的类型
+             * @param ptr 内存区域首指针
+             * @param n 要释放的对象个数
+             * @param alignment 分配时的对齐要求
+             */
+            template <::SoC::detail::is_known_type_allocatable<heap_t> type>
+            inline static void deallocate(type* ptr, ::std::size_t n, ::std::size_t alignment) noexcept(::SoC::optional_noexcept)
+            {
+                wrapper::heap->deallocate(ptr, sizeof(type) * n, ::std::max(alignment, alignof(type)));
+            }
+
+            /**
+             * @brief 释放通过对齐分配得到的ptr起连续size个字节的内存区域
+             *
+             * @param ptr 内存区域首指针
+             * @param size 要释放的字节数，需要和分配时保持一致
+             * @param alignment 分配时的对齐要求
+             */
+            inline static void deallocate(void* ptr, ::std::size_t size, ::std::size_t alignment) noexcept(
+                ::SoC::optional_noexcept)
+            {
+                wrapper::heap->deallocate(ptr, size, alignment);
+            }
+
             /**
              * @brief 比较两个分配器对象是否相同
              *
@@ -369,9 +1524,17 @@ export namespace SoC
             /**
              * @brief 将堆对象绑定到分配器
              *
+             * @tparam exact_heap_t 堆类型，必须与分配器中的堆指针类型完全相同。
+             * 目标平台上派生的堆只隐藏基类的allocate/deallocate，若允许绑定派生类，如SoC::interrupt_safe_heap，
+             * 分配器将调用基类版本而绕过派生类的临界区保护。单元测试中USE_VIRTUAL使其成为重写，运行时不会暴露该问题，
+             * 因此仅由该编译期约束防止
              * @param heap_ref 堆对象引用
              */
-            inline static void set_heap(::SoC::heap& heap_ref) noexcept { wrapper::heap = &heap_ref; }
+            template <::std::same_as<heap_t> exact_heap_t>
+            inline static void set_heap(exact_heap_t& heap_ref) noexcept
+            {
+                wrapper::heap = &heap_ref;
+            }
         };
     }  // namespace detail
 
@@ -388,22 +1551,53 @@ export namespace SoC
 
     public:
         using base_t::base_t;
+
+        /// 主内存可被DMA访问
+        constexpr inline static auto capability{::SoC::memory_capability::dma};
     } inline constexpr ram_allocator{};
 
     /**
      * @brief 适配ccmram堆的全局分配器
      *
      */
-    struct ccmram_heap_allocator_t : ::SoC::detail::heap_allocator_impl<::SoC::ccmram_heap_allocator_t>
+    struct ccmram_heap_allocator_t : ::SoC::detail::heap_allocator_impl<::SoC::ccmram_heap_allocator_t, ::SoC::ccmram_heap>
     {
     private:
-        constinit inline static ::SoC::heap* heap{};
-        using base_t = ::SoC::detail::heap_allocator_impl<::SoC::ccmram_heap_allocator_t>;
+        constinit inline static ::SoC::ccmram_heap* heap{};
+        using base_t = ::SoC::detail::heap_allocator_impl<::SoC::ccmram_heap_allocator_t, ::SoC::ccmram_heap>;
         friend base_t;
 
     public:
         using base_t::base_t;
+
+        /// ccmram仅CPU可访问，DMA无法访问
+        constexpr inline static auto capability{::SoC::memory_capability::cpu_only};
     } inline constexpr ccmram_allocator{};
+
+    /**
+     * @brief 适配可在中断中使用的主内存堆的全局分配器，分配和释放都在临界区中进行
+     *
+     */
+    struct interrupt_safe_ram_heap_allocator_t :
+        ::SoC::detail::heap_allocator_impl<::SoC::interrupt_safe_ram_heap_allocator_t, ::SoC::interrupt_safe_heap>
+    {
+    private:
+        constinit inline static ::SoC::interrupt_safe_heap* heap{};
+        using base_t = ::SoC::detail::heap_allocator_impl<::SoC::interrupt_safe_ram_heap_allocator_t, ::SoC::interrupt_safe_heap>;
+        friend base_t;
+
+    public:
+        using base_t::base_t;
+
+        /// 主内存可被DMA访问
+        constexpr inline static auto capability{::SoC::memory_capability::dma};
+    } inline constexpr interrupt_safe_ram_allocator{};
+
+    /// 将需要DMA访问的类型路由到主内存堆、其余对象路由到ccmram堆的全局分配器
+    using routing_allocator_t = ::SoC::basic_routing_allocator<::SoC::ram_heap_allocator_t, ::SoC::ccmram_heap_allocator_t>;
+
+    /// 将需要DMA访问的类型路由到主内存堆、其余对象路由到ccmram堆的全局分配器
+    inline constexpr ::SoC::routing_allocator_t routing_allocator{};
 }  // namespace SoC
 
 export namespace SoC
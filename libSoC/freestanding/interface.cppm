@@ -7,6 +7,7 @@
 export module SoC.freestanding;
 export import :utils;
 export import :allocator;
+export import :object_pool;
 export import :heap;
 export import :functional;
 export import :generator;
@@ -14,5 +15,8 @@ export import :pid;
 export import :fmt;
 export import :io;
 export import :ring_buffer;
+export import :bip_buffer;
 export import :priority_queue;
+export import :timing_wheel;
 export import :coroutine;
+export import :scheduler;
@@ -1310,6 +1310,37 @@ export namespace SoC
         }
     }
 
+    /**
+     * @brief 将二进制数据写入文件，数据超过缓冲区剩余空间时分段刷新
+     *
+     * @tparam flush 写入结束后是否刷新缓冲区
+     * @tparam file_t 二进制输出文件类型
+     * @param file 二进制输出文件
+     * @param data 要写入的数据
+     */
+    template <bool flush = false, ::SoC::is_output_file file_t>
+        requires ::std::same_as<typename file_t::value_type, ::std::byte>
+    constexpr inline void write_binary(file_t& file, ::std::span<const ::std::byte> data) noexcept
+    {
+        auto trait{::SoC::ofile_trait(file)};
+#pragma GCC unroll(0)
+        while(!data.empty())
+        {
+            if(trait.get_buffer_size_left() == 0) { trait.flush(); }
+            auto size{::std::min(data.size(), trait.get_buffer_size_left())};
+            trait.write(data.data(), size);
+            data = data.subspan(size);
+        }
+        if constexpr(flush)
+        {
+            if constexpr(::SoC::is_output_file_no_block_flushable<file_t>) { file.template flush<false>(); }
+            else
+            {
+                file.template flush<true>();
+            }
+        }
+    }
+
     /**
      * @brief 行尾序列
      *
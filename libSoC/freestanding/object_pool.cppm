@@ -0,0 +1,176 @@
+/**
+ * @file object_pool.cppm
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief 独立的定长对象池分配器实现
+ */
+
+export module SoC.freestanding:object_pool;
+import :utils;
+import :allocator;
+
+export namespace SoC
+{
+    /**
+     * @brief 定长对象池，满足SoC::is_static_allocator
+     *
+     * 池中有N个大小和对齐与type相同的槽，空闲槽通过侵入式链表串联，分配和释放都是常数时间。
+     * 未使用过的槽通过水位线按顺序取出，因此无需在启动时初始化空闲链表
+     * @tparam type 对象类型
+     * @tparam N 槽数量
+     * @tparam tag 用于区分相同对象类型的不同对象池的标签类型
+     * @note 任何大小和对齐不超过type的请求都占用一个槽，因此也可作为协程帧等同尺寸内存块的分配器；
+     * 对象池状态为全局共享，不可在中断中使用
+     */
+    template <typename type, ::std::size_t N, typename tag = void>
+        requires (N != 0)
+    struct object_pool
+    {
+    private:
+        /// 对象槽，空闲时复用存储空间保存链表指针
+        union slot
+        {
+            slot* next;
+            alignas(type) ::std::byte storage[sizeof(type)];  // NOLINT(modernize-avoid-c-arrays)
+        };
+
+        /// 槽大小
+        constexpr inline static auto slot_size{sizeof(slot)};
+        /// 槽对齐
+        constexpr inline static auto slot_align{alignof(slot)};
+
+        /// 对象槽数组
+        constinit inline static ::std::array<slot, N> slots{};
+        /// 空闲链表头
+        constinit inline static slot* free_list{};
+        /// 从未使用过的槽的起始索引
+        constinit inline static ::std::size_t watermark{};
+        /// 已分配的槽数
+        constinit inline static ::std::size_t used_cnt{};
+
+        /**
+         * @brief 取出一个空闲槽
+         *
+         * @param size 请求的字节数
+         * @param align 请求的对齐
+         * @return 槽首指针
+         */
+        inline static void* allocate_slot(::std::size_t size, ::std::size_t align) noexcept(::SoC::optional_noexcept)
+        {
+            using namespace ::std::string_view_literals;
+            if constexpr(::SoC::use_full_assert)
+            {
+                ::SoC::assert(size <= slot_size && align <= slot_align, "请求的大小或对齐超出对象池的槽"sv);
+            }
+            slot* result;
+            if(free_list != nullptr) [[likely]]
+            {
+                result = free_list;
+                free_list = result->next;
+            }
+            else
+            {
+                ::SoC::always_check(watermark != N, "对象池已用尽"sv);
+                result = &slots[watermark++];
+            }
+            ++used_cnt;
+            return result;
+        }
+
+    public:
+        /**
+         * @brief 分配一个槽
+         *
+         * @param size 要分配的字节数，不能超过槽大小
+         * @return 内存区域首指针
+         */
+        inline static void* allocate(::std::size_t size) noexcept(::SoC::optional_noexcept)
+        {
+            return allocate_slot(size, 1);
+        }
+
+        /**
+         * @brief 分配一个槽存放value_type类型对象
+         *
+         * @tparam value_type 要分配的类型
+         * @return 内存区域首指针
+         */
+        template <typename value_type>
+        inline static value_type* allocate() noexcept(::SoC::optional_noexcept)
+        {
+            return static_cast<value_type*>(allocate_slot(sizeof(value_type), alignof(value_type)));
+        }
+
+        /**
+         * @brief 分配一个槽存放连续n个value_type类型对象
+         *
+         * @tparam value_type 要分配的类型
+         * @param n 要分配的对象个数
+         * @return 内存区域首指针和槽可容纳的对象数
+         */
+        template <typename value_type>
+        inline static ::SoC::allocation_result<value_type*> allocate(::std::size_t n) noexcept(::SoC::optional_noexcept)
+        {
+            auto ptr{static_cast<value_type*>(allocate_slot(sizeof(value_type) * n, alignof(value_type)))};
+            return ::SoC::allocation_result<value_type*>{ptr, slot_size / sizeof(value_type)};
+        }
+
+        /**
+         * @brief 将ptr所在的槽放回空闲链表
+         *
+         * @param ptr 槽首指针
+         * @param size 分配时请求的字节数
+         */
+        inline static void deallocate(void* ptr, ::std::size_t size [[maybe_unused]]) noexcept(::SoC::optional_noexcept)
+        {
+            if constexpr(::SoC::use_full_assert)
+            {
+                using namespace ::std::string_view_literals;
+                auto address{reinterpret_cast<::std::uintptr_t>(ptr)};
+                auto begin{reinterpret_cast<::std::uintptr_t>(slots.data())};
+                ::SoC::assert(address >= begin && address < begin + slot_size * N && (address - begin) % slot_size == 0,
+                              "要释放的指针不属于对象池"sv);
+            }
+            free_list = ::new(ptr) slot{free_list};
+            --used_cnt;
+        }
+
+        /**
+         * @brief 释放n个value_type类型对象占用的槽
+         *
+         * @tparam value_type 要释放的类型
+         * @param ptr 槽首指针
+         * @param n 要释放的对象个数
+         */
+        template <typename value_type>
+        inline static void deallocate(value_type* ptr, ::std::size_t n = 1) noexcept(::SoC::optional_noexcept)
+        {
+            deallocate(static_cast<void*>(ptr), sizeof(value_type) * n);
+        }
+
+        /**
+         * @brief 获取已分配的槽数
+         *
+         * @return 已分配的槽数
+         */
+        [[nodiscard]] inline static ::std::size_t size() noexcept { return used_cnt; }
+
+        /**
+         * @brief 获取槽总数
+         *
+         * @return 槽总数
+         */
+        [[nodiscard]] constexpr inline static ::std::size_t capacity() noexcept { return N; }
+
+        /**
+         * @brief 比较两个分配器对象是否相同
+         *
+         * @param lhs 左操作数
+         * @param rhs 右操作数
+         * @return 分配器对象是否相同
+         */
+        constexpr inline friend bool operator== (object_pool lhs [[maybe_unused]], object_pool rhs [[maybe_unused]]) noexcept
+        {
+            return true;
+        }
+    };
+}  // namespace SoC
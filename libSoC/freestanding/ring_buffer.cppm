@@ -184,6 +184,93 @@ export
         dst_tail += moved_size;
         src_tail -= moved_size;
     }
+
+    /**
+     * @brief 将从逻辑索引index开始的n个槽位划分为至多两段连续区间，并依次处理
+     *
+     * @tparam buffer_size 缓冲区容量
+     * @param index 起始逻辑索引
+     * @param n 槽位数
+     * @param func 处理函数，参数为段在缓冲区中的起始下标、段长度和段在n个槽位中的偏移量
+     */
+    template <::std::size_t buffer_size>
+    constexpr inline void ring_buffer_for_each_segment(::std::size_t index, ::std::size_t n, auto&& func) noexcept(
+        ::SoC::optional_noexcept)
+    {
+        if(n == 0) [[unlikely]] { return; }
+        auto begin{index & (buffer_size - 1)};
+        auto first_cnt{::std::min(n, buffer_size - begin)};
+        func(begin, first_cnt, 0zu);
+        // 发生回绕时，第二段从缓冲区开头开始
+        if(first_cnt != n) { func(0zu, n - first_cnt, first_cnt); }
+    }
+
+    /**
+     * @brief 将元素批量复制到环形缓冲区从逻辑索引index开始的未初始化槽位，平凡可复制类型使用memcpy
+     *
+     * @tparam type 元素类型
+     * @tparam buffer_size 缓冲区容量
+     * @param buffer 缓冲区
+     * @param index 起始逻辑索引
+     * @param values 要复制的元素
+     */
+    template <typename type, ::std::size_t buffer_size>
+    constexpr inline void ring_buffer_copy_in(::std::span<::SoC::union_wrapper<type>, buffer_size> buffer,
+                                              ::std::size_t index,
+                                              ::std::span<const type> values) noexcept(::SoC::optional_noexcept)
+    {
+        ::SoC::detail::ring_buffer_for_each_segment<buffer_size>(
+            index,
+            values.size(),
+            [buffer, values](::std::size_t begin, ::std::size_t cnt, ::std::size_t offset)
+            {
+                if constexpr(::std::is_trivially_copyable_v<type>)
+                {
+                    if !consteval
+                    {
+                        ::std::memcpy(&buffer[begin], values.data() + offset, cnt * sizeof(type));
+                        return;
+                    }
+                }
+                for(auto i{0zu}; i != cnt; ++i) { ::new(&buffer[begin + i].value) type{values[offset + i]}; }
+            });
+    }
+
+    /**
+     * @brief 将环形缓冲区从逻辑索引index开始的元素批量移出并析构，平凡可复制类型使用memcpy
+     *
+     * @tparam type 元素类型
+     * @tparam buffer_size 缓冲区容量
+     * @param buffer 缓冲区
+     * @param index 起始逻辑索引
+     * @param output 用于保存元素的已构造区域，移出的元素数为output.size()
+     */
+    template <typename type, ::std::size_t buffer_size>
+    constexpr inline void ring_buffer_move_out(::std::span<::SoC::union_wrapper<type>, buffer_size> buffer,
+                                               ::std::size_t index,
+                                               ::std::span<type> output) noexcept(::SoC::optional_noexcept)
+    {
+        ::SoC::detail::ring_buffer_for_each_segment<buffer_size>(
+            index,
+            output.size(),
+            [buffer, output](::std::size_t begin, ::std::size_t cnt, ::std::size_t offset)
+            {
+                if constexpr(::std::is_trivially_copyable_v<type>)
+                {
+                    if !consteval
+                    {
+                        ::std::memcpy(output.data() + offset, &buffer[begin], cnt * sizeof(type));
+                        return;
+                    }
+                }
+                for(auto i{0zu}; i != cnt; ++i)
+                {
+                    auto&& ref{buffer[begin + i].value};
+                    output[offset + i] = ::std::move(ref);
+                    ref.~type();
+                }
+            });
+    }
 }  // namespace SoC::detail
 
 export namespace SoC
@@ -658,6 +745,21 @@ export namespace SoC
          */
         [[nodiscard]] constexpr inline ::std::size_t capacity() const noexcept { return buffer_size; }
 
+        /**
+         * @brief 将缓冲区中的元素按存储位置划分为至多两个连续段，便于编译器展开和向量化
+         *
+         * @return 依次为从头部开始的段和回绕后从缓冲区开头开始的段，未回绕时第二段为空
+         */
+        [[nodiscard]] constexpr inline auto segments(this auto&& self) noexcept
+        {
+            using segment_t = ::std::span<
+                ::std::conditional_t<::std::is_const_v<::std::remove_reference_t<decltype(self)>>, const value_type, value_type>>;
+            auto begin{self.head & buffer_mask};
+            auto first_size{::std::min(self.size(), buffer_size - begin)};
+            return ::std::array{segment_t{&self.buffer[begin].value, first_size},
+                                segment_t{&self.buffer[0].value, self.size() - first_size}};
+        }
+
         /**
          * @brief 访问缓冲区第一个元素
          *
@@ -709,6 +811,105 @@ export namespace SoC
             ref.~value_type();
         }
 
+        /**
+         * @brief 向缓冲区末尾批量复制元素，至多分两段进行，平凡可复制类型使用memcpy
+         *
+         * @param values 要添加的元素
+         */
+        constexpr inline void push_back_range(::std::span<const value_type> values) noexcept(::SoC::optional_noexcept)
+        {
+            using namespace ::std::string_view_literals;
+            ::SoC::always_check(values.size() <= buffer_size - size(), "环形缓冲区剩余空间不足"sv);
+            ::SoC::detail::ring_buffer_copy_in<value_type, buffer_size>(buffer, tail, values);
+            tail += values.size();
+        }
+
+        /**
+         * @brief 从缓冲区头部批量取出元素，至多分两段进行，平凡可复制类型使用memcpy
+         *
+         * @param output 用于保存取出元素的区域，取出的元素数为output.size()
+         */
+        constexpr inline void pop_front_into(::std::span<value_type> output) noexcept(::SoC::optional_noexcept)
+        {
+            using namespace ::std::string_view_literals;
+            ::SoC::always_check(output.size() <= size(), "环形缓冲区中的元素不足"sv);
+            ::SoC::detail::ring_buffer_move_out<value_type, buffer_size>(buffer, head, output);
+            head += output.size();
+        }
+
+        /**
+         * @brief 从缓冲区头部丢弃n个元素
+         *
+         * @param n 要丢弃的元素数
+         */
+        constexpr inline void discard(::std::size_t n) noexcept(::SoC::optional_noexcept)
+        {
+            using namespace ::std::string_view_literals;
+            ::SoC::always_check(n <= size(), "环形缓冲区中的元素不足"sv);
+            if constexpr(!::std::is_trivially_destructible_v<value_type>)
+            {
+                ::SoC::detail::ring_buffer_for_each_segment<buffer_size>(
+                    head,
+                    n,
+                    [this](::std::size_t begin, ::std::size_t cnt, ::std::size_t offset [[maybe_unused]])
+                    {
+                        for(auto i{0zu}; i != cnt; ++i) { buffer[begin + i].value.~value_type(); }
+                    });
+            }
+            head += n;
+        }
+
+        /**
+         * @brief 获取从尾部开始的最大连续可写区域，写入后通过commit发布，可供DMA或std::to_chars直接写入
+         *
+         * @return 连续可写区域，缓冲区已满时为空
+         * @note 区域中的元素未经构造，因此仅支持平凡可复制类型
+         */
+        [[nodiscard]] constexpr inline ::std::span<value_type> write_region() noexcept
+            requires (::std::is_trivially_copyable_v<value_type>)
+        {
+            auto begin{tail & buffer_mask};
+            return {&buffer[begin].value, ::std::min(buffer_size - size(), buffer_size - begin)};
+        }
+
+        /**
+         * @brief 将write_region返回区域的前n个元素发布到缓冲区末尾
+         *
+         * @param n 已写入的元素数
+         */
+        constexpr inline void commit(::std::size_t n) noexcept(::SoC::optional_noexcept)
+            requires (::std::is_trivially_copyable_v<value_type>)
+        {
+            using namespace ::std::string_view_literals;
+            ::SoC::always_check(n <= write_region().size(), "提交的元素数超过连续可写区域"sv);
+            tail += n;
+        }
+
+        /**
+         * @brief 获取从头部开始的最大连续可读区域，读取后通过consume释放，可供DMA直接发送
+         *
+         * @return 连续可读区域，缓冲区为空时为空
+         */
+        [[nodiscard]] constexpr inline ::std::span<const value_type> read_region() const noexcept
+            requires (::std::is_trivially_copyable_v<value_type>)
+        {
+            auto begin{head & buffer_mask};
+            return {&buffer[begin].value, ::std::min(size(), buffer_size - begin)};
+        }
+
+        /**
+         * @brief 从缓冲区头部释放read_region返回区域的前n个元素
+         *
+         * @param n 已读取的元素数
+         */
+        constexpr inline void consume(::std::size_t n) noexcept(::SoC::optional_noexcept)
+            requires (::std::is_trivially_copyable_v<value_type>)
+        {
+            using namespace ::std::string_view_literals;
+            ::SoC::always_check(n <= read_region().size(), "释放的元素数超过连续可读区域"sv);
+            head += n;
+        }
+
         /**
          * @brief 检查两个环形缓冲区是否相等
          *
@@ -721,4 +922,245 @@ export namespace SoC
             return ::std::ranges::equal(lhs, rhs);
         }
     };
+
+    /**
+     * @brief 按段将环形缓冲区中的元素复制到output，每段退化为连续内存上的复制
+     *
+     * @tparam type 元素类型
+     * @tparam buffer_size 缓冲区容量
+     * @tparam output_iterator 输出迭代器类型
+     * @param buffer 环形缓冲区
+     * @param output 输出迭代器
+     * @return 指向最后一个复制元素之后的输出迭代器
+     */
+    template <typename type, ::std::size_t buffer_size, ::std::weakly_incrementable output_iterator>
+        requires ::std::indirectly_copyable<const type*, output_iterator>
+    constexpr inline output_iterator copy(const ::SoC::ring_buffer<type, buffer_size>& buffer, output_iterator output)
+    {
+        for(auto segment: buffer.segments()) { output = ::std::ranges::copy(segment, ::std::move(output)).out; }
+        return output;
+    }
+
+    /**
+     * @brief 按段对环形缓冲区中的每个元素调用func
+     *
+     * @tparam type 元素类型
+     * @tparam buffer_size 缓冲区容量
+     * @tparam function_t 函数类型
+     * @param buffer 环形缓冲区
+     * @param func 要调用的函数
+     * @return 调用完成后的函数对象
+     */
+    template <typename type, ::std::size_t buffer_size, ::std::invocable<type&> function_t>
+    constexpr inline function_t for_each(::SoC::ring_buffer<type, buffer_size>& buffer, function_t func)
+    {
+        for(auto segment: buffer.segments()) { func = ::std::ranges::for_each(segment, ::std::move(func)).fun; }
+        return func;
+    }
+
+    /**
+     * @brief 按段对常量环形缓冲区中的每个元素调用func
+     *
+     * @tparam type 元素类型
+     * @tparam buffer_size 缓冲区容量
+     * @tparam function_t 函数类型
+     * @param buffer 环形缓冲区
+     * @param func 要调用的函数
+     * @return 调用完成后的函数对象
+     */
+    template <typename type, ::std::size_t buffer_size, ::std::invocable<const type&> function_t>
+    constexpr inline function_t for_each(const ::SoC::ring_buffer<type, buffer_size>& buffer, function_t func)
+    {
+        for(auto segment: buffer.segments()) { func = ::std::ranges::for_each(segment, ::std::move(func)).fun; }
+        return func;
+    }
+
+    /**
+     * @brief 按段从左向右折叠环形缓冲区中的元素，如对采样窗口求和
+     *
+     * @tparam type 元素类型
+     * @tparam buffer_size 缓冲区容量
+     * @tparam init_t 初始值类型
+     * @tparam operation_t 二元操作类型
+     * @param buffer 环形缓冲区
+     * @param init 初始值
+     * @param operation 二元操作
+     * @return 折叠结果
+     */
+    template <typename type, ::std::size_t buffer_size, typename init_t, typename operation_t>
+    constexpr inline auto fold(const ::SoC::ring_buffer<type, buffer_size>& buffer, init_t init, operation_t operation)
+    {
+        auto [first, second]{buffer.segments()};
+        return ::std::ranges::fold_left(second, ::std::ranges::fold_left(first, ::std::move(init), operation), operation);
+    }
+
+    /**
+     * @brief 无锁单生产者单消费者环形缓冲区，适用于中断与主循环之间传递数据
+     *
+     * 生产者只写tail、消费者只写head，通过acquire/release顺序发布元素，因此无需关闭中断。
+     * 宿主平台上两个索引和缓冲区分别位于不同的缓存行，避免两个线程间的伪共享
+     * @tparam type 元素类型
+     * @tparam buffer_size 缓冲区容量
+     * @note 生产者侧函数只能在一个上下文中调用，消费者侧函数只能在另一个上下文中调用
+     */
+    template <typename type, ::std::size_t buffer_size>
+        requires (::std::has_single_bit(buffer_size))
+    struct spsc_ring_buffer
+    {
+        using value_type = type;
+        using size_type = ::std::size_t;
+
+    private:
+        /// 索引的对齐，宿主平台上按缓存行对齐，单片机上没有缓存因此不填充
+        constexpr inline static ::std::size_t index_align{::SoC::in_unit_test ? 64zu : alignof(::std::atomic_size_t)};
+        /// 缓冲区容量掩码
+        constexpr inline static ::std::size_t buffer_mask{buffer_size - 1};
+
+        /// 头索引，仅由消费者修改
+        alignas(index_align) ::std::atomic_size_t head{};
+        /// 尾索引，仅由生产者修改
+        alignas(index_align) ::std::atomic_size_t tail{};
+        alignas(index_align) ::std::array<::SoC::union_wrapper<type>, buffer_size> buffer{};
+
+    public:
+        /**
+         * @brief 构造一个无锁单生产者单消费者环形缓冲区
+         *
+         */
+        constexpr inline spsc_ring_buffer() noexcept = default;
+
+        spsc_ring_buffer(const spsc_ring_buffer&) = delete;
+        spsc_ring_buffer& operator= (const spsc_ring_buffer&) = delete;
+
+        /**
+         * @brief 析构一个无锁单生产者单消费者环形缓冲区，要求此时没有并发访问
+         *
+         */
+        constexpr inline ~spsc_ring_buffer() noexcept
+        {
+            if constexpr(!::std::is_trivially_destructible_v<value_type>)
+            {
+                ::SoC::detail::ring_buffer_destructor<value_type>(head.load(::std::memory_order_relaxed),
+                                                                  tail.load(::std::memory_order_relaxed),
+                                                                  buffer);
+            }
+        }
+
+        /**
+         * @brief 获取缓冲区容量
+         *
+         * @return 缓冲区容量
+         */
+        [[nodiscard]] constexpr inline ::std::size_t capacity() const noexcept { return buffer_size; }
+
+        /**
+         * @brief 获取缓冲区已用大小，并发访问时仅为快照
+         *
+         * @return 已用大小
+         */
+        [[nodiscard]] inline ::std::size_t size() const noexcept
+        {
+            auto current_head{head.load(::std::memory_order_acquire)};
+            return tail.load(::std::memory_order_acquire) - current_head;
+        }
+
+        /**
+         * @brief 检查缓冲区是否为空，并发访问时仅为快照
+         *
+         * @return 缓冲区是否为空
+         */
+        [[nodiscard]] inline bool empty() const noexcept { return size() == 0; }
+
+        /**
+         * @brief 生产者尝试在缓冲区末尾构造元素
+         *
+         * @tparam args_t 构造参数类型
+         * @param args 构造参数列表
+         * @return 缓冲区已满时返回false
+         */
+        template <typename... args_t>
+            requires ::std::constructible_from<value_type, args_t...>
+        [[nodiscard]] inline bool try_emplace(args_t&&... args) noexcept(::std::is_nothrow_constructible_v<value_type, args_t...>)
+        {
+            auto current_tail{tail.load(::std::memory_order_relaxed)};
+            // 获取消费者释放的槽位，保证其对槽位的读取先于此处的写入
+            if(current_tail - head.load(::std::memory_order_acquire) == buffer_size) { return false; }
+            ::new(&buffer[current_tail & buffer_mask].value) value_type{::std::forward<args_t>(args)...};
+            // 发布元素，保证消费者看到新的tail时元素已构造完成
+            tail.store(current_tail + 1, ::std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief 生产者尝试在缓冲区末尾添加元素
+         *
+         * @param value 要添加的元素
+         * @return 缓冲区已满时返回false
+         */
+        [[nodiscard]] inline bool try_push(const value_type& value) noexcept(::std::is_nothrow_copy_constructible_v<value_type>)
+        {
+            return try_emplace(value);
+        }
+
+        /**
+         * @brief 生产者尝试在缓冲区末尾添加元素
+         *
+         * @param value 要添加的元素
+         * @return 缓冲区已满时返回false
+         */
+        [[nodiscard]] inline bool try_push(value_type&& value) noexcept(::std::is_nothrow_move_constructible_v<value_type>)
+        {
+            return try_emplace(::std::move(value));
+        }
+
+        /**
+         * @brief 生产者向缓冲区末尾批量复制尽可能多的元素，至多分两段进行，平凡可复制类型使用memcpy
+         *
+         * @param values 要添加的元素
+         * @return 实际添加的元素数
+         */
+        [[nodiscard]] inline ::std::size_t try_push_range(::std::span<const value_type> values) noexcept(::SoC::optional_noexcept)
+        {
+            auto current_tail{tail.load(::std::memory_order_relaxed)};
+            auto free_size{buffer_size - (current_tail - head.load(::std::memory_order_acquire))};
+            auto cnt{::std::min(free_size, values.size())};
+            ::SoC::detail::ring_buffer_copy_in<value_type, buffer_size>(buffer, current_tail, values.first(cnt));
+            tail.store(current_tail + cnt, ::std::memory_order_release);
+            return cnt;
+        }
+
+        /**
+         * @brief 消费者尝试从缓冲区头部取出元素
+         *
+         * @param output 用于保存取出元素的对象
+         * @return 缓冲区为空时返回false
+         */
+        [[nodiscard]] inline bool try_pop(value_type& output) noexcept(::std::is_nothrow_move_assignable_v<value_type>)
+        {
+            auto current_head{head.load(::std::memory_order_relaxed)};
+            // 获取生产者发布的元素
+            if(current_head == tail.load(::std::memory_order_acquire)) { return false; }
+            auto&& ref{buffer[current_head & buffer_mask].value};
+            output = ::std::move(ref);
+            ref.~value_type();
+            // 释放槽位，保证生产者看到新的head时此处对槽位的访问已完成
+            head.store(current_head + 1, ::std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief 消费者从缓冲区头部批量取出尽可能多的元素，至多分两段进行，平凡可复制类型使用memcpy
+         *
+         * @param output 用于保存取出元素的区域
+         * @return 实际取出的元素数
+         */
+        [[nodiscard]] inline ::std::size_t try_pop_range(::std::span<value_type> output) noexcept(::SoC::optional_noexcept)
+        {
+            auto current_head{head.load(::std::memory_order_relaxed)};
+            auto cnt{::std::min(tail.load(::std::memory_order_acquire) - current_head, output.size())};
+            ::SoC::detail::ring_buffer_move_out<value_type, buffer_size>(buffer, current_head, output.first(cnt));
+            head.store(current_head + cnt, ::std::memory_order_release);
+            return cnt;
+        }
+    };
 }  // namespace SoC
@@ -0,0 +1,666 @@
+/**
+ * @file scheduler.cppm
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief 协程调度器实现
+ *
+ * 本模块提供基于系统时刻驱动的协程调度器，以及调度器使用的就绪队列和等待队列
+ */
+
+export module SoC.freestanding:scheduler;
+import :utils;
+import :ring_buffer;
+import :priority_queue;
+import :coroutine;
+import :timing_wheel;
+
+export namespace SoC
+{
+    namespace detail
+    {
+        /**
+         * @brief 等待队列节点
+         *
+         */
+        struct wait_queue_node
+        {
+            /// 唤醒协程的目标系统时刻
+            ::std::uint64_t target_tick;
+            /// 等待的协程柄
+            ::std::coroutine_handle<> handle;
+
+            /**
+             * @brief 按目标系统时刻比较等待队列节点
+             *
+             * @param lhs 左操作数
+             * @param rhs 右操作数
+             * @return 比较结果
+             */
+            constexpr inline friend auto operator<=> (const wait_queue_node& lhs, const wait_queue_node& rhs) noexcept
+            {
+                return lhs.target_tick <=> rhs.target_tick;
+            }
+
+            /**
+             * @brief 按目标系统时刻判断等待队列节点是否相等
+             *
+             * @param lhs 左操作数
+             * @param rhs 右操作数
+             * @return 是否相等
+             */
+            constexpr inline friend bool operator== (const wait_queue_node& lhs, const wait_queue_node& rhs) noexcept
+            {
+                return lhs.target_tick == rhs.target_tick;
+            }
+        };
+
+        /**
+         * @brief 最早截止时刻优先就绪队列节点
+         *
+         */
+        struct edf_queue_node
+        {
+            /// 协程的绝对截止时刻
+            ::std::uint64_t deadline;
+            /// 入队序号，截止时刻相同时先入队者优先
+            ::std::uint64_t sequence;
+            /// 就绪的协程柄
+            ::std::coroutine_handle<> handle;
+
+            /**
+             * @brief 按绝对截止时刻和入队序号比较节点
+             *
+             * @param lhs 左操作数
+             * @param rhs 右操作数
+             * @return 比较结果
+             */
+            constexpr inline friend auto operator<=> (const edf_queue_node& lhs, const edf_queue_node& rhs) noexcept
+            {
+                auto result{lhs.deadline <=> rhs.deadline};
+                return result != 0 ? result : lhs.sequence <=> rhs.sequence;
+            }
+
+            /**
+             * @brief 按绝对截止时刻和入队序号判断节点是否相等
+             *
+             * @param lhs 左操作数
+             * @param rhs 右操作数
+             * @return 是否相等
+             */
+            constexpr inline friend bool operator== (const edf_queue_node& lhs, const edf_queue_node& rhs) noexcept
+            {
+                return lhs.deadline == rhs.deadline && lhs.sequence == rhs.sequence;
+            }
+        };
+
+        /**
+         * @brief 无节拍休眠被提前唤醒时的时刻修正结果
+         *
+         */
+        struct tickless_wakeup_t
+        {
+            /// 休眠期间经过的系统时刻边界数
+            ::std::uint32_t elapsed_ticks;
+            /// 唤醒时距下一个系统时刻边界的周期数，取值范围为[1, 每个系统时刻的周期数]
+            ::std::uint32_t next_tick_cycles;
+        };
+
+        /**
+         * @brief 计算无节拍休眠被提前唤醒时经过的系统时刻数，以及保持系统时刻相位所需的下一次重装载周期数
+         *
+         * @param remain 进入休眠时当前系统时刻剩余的周期数，即第一个系统时刻边界距休眠开始的周期数
+         * @param elapsed 休眠开始后经过的周期数
+         * @param cycles 每个系统时刻的周期数
+         * @return 时刻修正结果
+         */
+        [[nodiscard]] constexpr inline ::SoC::detail::tickless_wakeup_t
+            get_tickless_wakeup(::std::uint32_t remain, ::std::uint32_t elapsed, ::std::uint32_t cycles) noexcept
+        {
+            // 尚未经过第一个系统时刻边界
+            if(elapsed < remain) { return {0, remain - elapsed}; }
+            auto passed{elapsed - remain};
+            return {passed / cycles + 1, cycles - passed % cycles};
+        }
+    }  // namespace detail
+
+    /**
+     * @brief 判断type是否为就绪队列，要求满足：
+     * - void type::push_back(std::coroutine_handle<>)，且
+     * - std::coroutine_handle<> type::pop_front()，且
+     * - bool type::empty() const，且
+     * - std::size_t type::size() const
+     * @tparam type 要判断的类型
+     */
+    template <typename type>
+    concept is_ready_queue = ::std::default_initializable<type> &&
+                             requires(type& queue, const type& const_queue, ::std::coroutine_handle<> handle) {
+                                 { queue.push_back(handle) } -> ::std::same_as<void>;
+                                 { queue.pop_front() } -> ::std::same_as<::std::coroutine_handle<>>;
+                                 { const_queue.empty() } -> ::std::same_as<bool>;
+                                 { const_queue.size() } -> ::std::same_as<::std::size_t>;
+                             };
+
+    /**
+     * @brief 判断type是否为等待队列，要求满足：
+     * - void type::push_back(std::coroutine_handle<>, std::uint64_t)，且
+     * - std::uint64_t type::next_tick() const，且
+     * - bool type::empty() const，且
+     * - void type::expire(std::uint64_t, callback)
+     * @tparam type 要判断的类型
+     */
+    template <typename type>
+    concept is_wait_queue =
+        ::std::default_initializable<type> &&
+        requires(type& queue, const type& const_queue, ::std::coroutine_handle<> handle, ::std::uint64_t tick) {
+            { queue.push_back(handle, tick) } -> ::std::same_as<void>;
+            { const_queue.next_tick() } -> ::std::same_as<::std::uint64_t>;
+            { const_queue.empty() } -> ::std::same_as<bool>;
+            queue.expire(tick, [](::std::coroutine_handle<>) static noexcept {});
+        };
+
+    /**
+     * @brief 判断type是否为调度器时钟，要求满足：
+     * - std::uint64_t type::now()，且
+     * - void type::sleep_until(std::uint64_t)
+     * @tparam type 要判断的类型
+     */
+    template <typename type>
+    concept is_scheduler_clock = ::std::default_initializable<type> && requires(type& clock, ::std::uint64_t tick) {
+        { clock.now() } -> ::std::same_as<::std::uint64_t>;
+        { clock.sleep_until(tick) } -> ::std::same_as<void>;
+    };
+
+    /**
+     * @brief 由系统时刻中断驱动的调度器时钟
+     *
+     */
+    struct systick_clock
+    {
+        /**
+         * @brief 获取当前系统时刻
+         *
+         * @return 当前系统时刻
+         */
+        [[nodiscard]] inline ::std::uint64_t now() const noexcept(::SoC::optional_noexcept) { return ::SoC::get_systick(); }
+
+        /**
+         * @brief 让出CPU直到下一次中断，调度器会在到期前反复调用本函数
+         *
+         * @param target_tick 最早的等待协程到期的系统时刻
+         */
+        inline void sleep_until([[maybe_unused]] ::std::uint64_t target_tick) const noexcept(::SoC::optional_noexcept)
+        {
+            ::SoC::yield_cpu();
+        }
+    };
+
+    /**
+     * @brief 基于环形缓冲区的先进先出就绪队列
+     *
+     * @tparam buffer_size 队列容量，必须是2的幂
+     */
+    template <::std::size_t buffer_size>
+    struct fifo_ready_queue
+    {
+    private:
+        ::SoC::ring_buffer<::std::coroutine_handle<>, buffer_size> queue{};
+
+    public:
+        /**
+         * @brief 将协程柄插入队列尾部
+         *
+         * @param handle 要插入的协程柄
+         */
+        constexpr inline void push_back(::std::coroutine_handle<> handle) noexcept(::SoC::optional_noexcept)
+        {
+            queue.emplace_back(handle);
+        }
+
+        /**
+         * @brief 从队列头部取出协程柄
+         *
+         * @return 取出的协程柄
+         */
+        constexpr inline ::std::coroutine_handle<> pop_front() noexcept(::SoC::optional_noexcept)
+        {
+            auto handle{queue.front()};
+            queue.pop_front();
+            return handle;
+        }
+
+        /**
+         * @brief 判断队列是否为空
+         *
+         * @return 队列是否为空
+         */
+        [[nodiscard]] constexpr inline bool empty() const noexcept { return queue.empty(); }
+
+        /**
+         * @brief 获取队列中的协程数
+         *
+         * @return 协程数
+         */
+        [[nodiscard]] constexpr inline ::std::size_t size() const noexcept { return queue.size(); }
+    };
+
+    /**
+     * @brief 多级优先级就绪队列，每个优先级对应一个先进先出环形缓冲区
+     *
+     * 使用32位占用位图记录非空的优先级，优先级level对应位图的第(31 - level)位，
+     * 因此可以通过一次std::countl_zero在常数时间内找到最高的可运行优先级
+     * @tparam level_cnt 优先级数量，不超过32
+     * @tparam level_size 每个优先级的队列容量，必须是2的幂
+     * @note 协程的优先级取自SoC::detail::promise_base_no_allocator::priority，越小优先级越高，
+     * 超出范围的优先级视为最低优先级
+     */
+    template <::std::size_t level_cnt, ::std::size_t level_size>
+        requires (level_cnt >= 1 && level_cnt <= 32)
+    struct priority_ready_queue
+    {
+    private:
+        /// 各优先级的先进先出队列
+        ::std::array<::SoC::ring_buffer<::std::coroutine_handle<>, level_size>, level_cnt> queues{};
+        /// 占用位图，第(31 - level)位为1表示优先级level非空
+        ::std::uint32_t bitmap{};
+        /// 队列中的协程总数
+        ::std::size_t count{};
+
+        /**
+         * @brief 获取优先级在占用位图中对应的掩码
+         *
+         * @param level 优先级
+         * @return 掩码
+         */
+        [[using gnu: always_inline, artificial]] constexpr inline static ::std::uint32_t
+            get_level_mask(::std::size_t level) noexcept
+        {
+            return 0x8000'0000u >> level;
+        }
+
+    public:
+        /**
+         * @brief 将协程柄插入其优先级对应的队列尾部
+         *
+         * @param handle 要插入的协程柄
+         */
+        constexpr inline void push_back(::std::coroutine_handle<> handle) noexcept(::SoC::optional_noexcept)
+        {
+            auto priority{::SoC::get_promise<::SoC::detail::promise_base_no_allocator>(handle).priority};
+            auto level{::std::min<::std::size_t>(priority, level_cnt - 1)};
+            queues[level].emplace_back(handle);
+            bitmap |= get_level_mask(level);
+            ++count;
+        }
+
+        /**
+         * @brief 从最高的非空优先级队列头部取出协程柄
+         *
+         * @return 取出的协程柄
+         */
+        constexpr inline ::std::coroutine_handle<> pop_front() noexcept(::SoC::optional_noexcept)
+        {
+            using namespace ::std::string_view_literals;
+            ::SoC::always_check(bitmap != 0, "优先级就绪队列已空"sv);
+            auto level{static_cast<::std::size_t>(::std::countl_zero(bitmap))};
+            auto&& queue{queues[level]};
+            auto handle{queue.front()};
+            queue.pop_front();
+            if(queue.empty()) { bitmap &= ~get_level_mask(level); }
+            --count;
+            return handle;
+        }
+
+        /**
+         * @brief 判断队列是否为空
+         *
+         * @return 队列是否为空
+         */
+        [[nodiscard]] constexpr inline bool empty() const noexcept { return bitmap == 0; }
+
+        /**
+         * @brief 获取队列中的协程数
+         *
+         * @return 协程数
+         */
+        [[nodiscard]] constexpr inline ::std::size_t size() const noexcept { return count; }
+
+        /**
+         * @brief 获取指定优先级队列中的协程数
+         *
+         * @param level 优先级
+         * @return 协程数
+         */
+        [[nodiscard]] constexpr inline ::std::size_t size(::std::size_t level) const noexcept { return queues[level].size(); }
+    };
+
+    /**
+     * @brief 最早截止时刻优先（EDF）就绪队列
+     *
+     * 协程每次进入就绪队列时视为释放一个作业，其绝对截止时刻为入队时刻加上相对截止时刻，
+     * 出队时总是取出绝对截止时刻最早的协程。协程在绝对截止时刻之后才被取出时计为一次截止时刻错过
+     * @tparam buffer_size 队列容量
+     * @tparam clock_t 用于计算绝对截止时刻的调度器时钟类型
+     * @note 相对截止时刻取自SoC::detail::promise_base_no_allocator::relative_deadline，
+     * 为0的协程没有截止时刻，仅在所有有截止时刻的协程之后执行
+     */
+    template <::std::size_t buffer_size, ::SoC::is_scheduler_clock clock_t = ::SoC::systick_clock>
+    struct edf_ready_queue
+    {
+    private:
+        /// 小顶堆，堆顶为绝对截止时刻最早的协程
+        ::SoC::priority_queue<::SoC::detail::edf_queue_node, buffer_size, ::std::greater> queue{};
+        /// 调度器时钟
+        [[no_unique_address]] clock_t clock{};
+        /// 下一个入队序号
+        ::std::uint64_t sequence{};
+        /// 截止时刻错过次数
+        ::std::size_t deadline_miss_cnt{};
+
+    public:
+        /**
+         * @brief 计算协程的绝对截止时刻并插入队列
+         *
+         * @param handle 要插入的协程柄
+         */
+        constexpr inline void push_back(::std::coroutine_handle<> handle) noexcept(::SoC::optional_noexcept)
+        {
+            auto relative_deadline{::SoC::get_promise<::SoC::detail::promise_base_no_allocator>(handle).relative_deadline};
+            auto deadline{relative_deadline == 0 ? ::std::numeric_limits<::std::uint64_t>::max()
+                                                 : clock.now() + relative_deadline};
+            queue.emplace_back(deadline, sequence++, handle);
+        }
+
+        /**
+         * @brief 取出绝对截止时刻最早的协程柄，并统计截止时刻错过
+         *
+         * @return 取出的协程柄
+         */
+        constexpr inline ::std::coroutine_handle<> pop_front() noexcept(::SoC::optional_noexcept)
+        {
+            using namespace ::std::string_view_literals;
+            ::SoC::always_check(!queue.empty(), "最早截止时刻优先就绪队列已空"sv);
+            auto deadline{queue.top().deadline};
+            auto handle{queue.top().handle};
+            queue.pop_front();
+            if(deadline < clock.now()) { ++deadline_miss_cnt; }
+            return handle;
+        }
+
+        /**
+         * @brief 判断队列是否为空
+         *
+         * @return 队列是否为空
+         */
+        [[nodiscard]] constexpr inline bool empty() const noexcept { return queue.empty(); }
+
+        /**
+         * @brief 获取队列中的协程数
+         *
+         * @return 协程数
+         */
+        [[nodiscard]] constexpr inline ::std::size_t size() const noexcept { return queue.size(); }
+
+        /**
+         * @brief 获取最早的绝对截止时刻
+         *
+         * @return 最早的绝对截止时刻，队列为空或没有截止时刻时为std::uint64_t的最大值
+         */
+        [[nodiscard]] constexpr inline ::std::uint64_t next_deadline() const noexcept
+        {
+            return queue.empty() ? ::std::numeric_limits<::std::uint64_t>::max() : queue.top().deadline;
+        }
+
+        /**
+         * @brief 获取截止时刻错过次数
+         *
+         * @return 截止时刻错过次数
+         */
+        [[nodiscard]] constexpr inline ::std::size_t get_deadline_miss_cnt() const noexcept { return deadline_miss_cnt; }
+
+        /**
+         * @brief 清零截止时刻错过次数
+         *
+         */
+        constexpr inline void reset_deadline_miss_cnt() noexcept { deadline_miss_cnt = 0; }
+    };
+
+    /**
+     * @brief 基于二叉堆的等待队列，按目标系统时刻排序
+     *
+     * @tparam buffer_size 队列容量
+     */
+    template <::std::size_t buffer_size>
+    struct heap_wait_queue
+    {
+    private:
+        /// 小顶堆，堆顶为最早到期的协程
+        ::SoC::priority_queue<::SoC::detail::wait_queue_node, buffer_size, ::std::greater> queue{};
+
+    public:
+        /**
+         * @brief 将协程柄插入等待队列
+         *
+         * @param handle 要插入的协程柄
+         * @param target_tick 唤醒协程的目标系统时刻
+         */
+        constexpr inline void push_back(::std::coroutine_handle<> handle, ::std::uint64_t target_tick) noexcept(
+            ::SoC::optional_noexcept)
+        {
+            queue.emplace_back(target_tick, handle);
+        }
+
+        /**
+         * @brief 获取最早到期的目标系统时刻
+         *
+         * @return 最早到期的目标系统时刻，队列为空时为最大值
+         */
+        [[nodiscard]] constexpr inline ::std::uint64_t next_tick() const noexcept
+        {
+            return queue.empty() ? ::std::numeric_limits<::std::uint64_t>::max() : queue.top().target_tick;
+        }
+
+        /**
+         * @brief 判断队列是否为空
+         *
+         * @return 队列是否为空
+         */
+        [[nodiscard]] constexpr inline bool empty() const noexcept { return queue.empty(); }
+
+        /**
+         * @brief 获取队列中的协程数
+         *
+         * @return 协程数
+         */
+        [[nodiscard]] constexpr inline ::std::size_t size() const noexcept { return queue.size(); }
+
+        /**
+         * @brief 取出所有在now时刻及以前到期的协程
+         *
+         * @param now 当前系统时刻
+         * @param callback 对每个到期的协程柄调用的回调函数
+         */
+        constexpr inline void expire(::std::uint64_t now, auto&& callback) noexcept(::SoC::optional_noexcept)
+        {
+            while(!queue.empty() && queue.top().target_tick <= now)
+            {
+                callback(queue.top().handle);
+                queue.pop_front();
+            }
+        }
+    };
+
+    /**
+     * @brief 由系统时刻驱动的协程调度器
+     *
+     * @tparam ready_queue_t 就绪队列类型
+     * @tparam wait_queue_t 等待队列类型
+     * @tparam clock_t 调度器时钟类型，决定空闲时的休眠方式
+     */
+    template <::SoC::is_ready_queue ready_queue_t,
+              ::SoC::is_wait_queue wait_queue_t,
+              ::SoC::is_scheduler_clock clock_t = ::SoC::systick_clock>
+    struct basic_scheduler : ::SoC::scheduler_base
+    {
+    private:
+        /**
+         * @brief 构造等待队列，若等待队列支持指定起始时刻则以调度器时钟的当前时刻为起点
+         *
+         * @param clock 调度器时钟
+         * @return 等待队列
+         */
+        [[nodiscard]] inline static wait_queue_t make_wait_queue(clock_t& clock) noexcept(::SoC::optional_noexcept)
+        {
+            if constexpr(::std::constructible_from<wait_queue_t, ::std::uint64_t>) { return wait_queue_t{clock.now()}; }
+            else
+            {
+                return wait_queue_t{};
+            }
+        }
+
+        /// 调度器时钟，须先于等待队列初始化
+        [[no_unique_address]] clock_t clock{};
+        /// 就绪队列
+        ready_queue_t ready_queue{};
+        /// 等待队列
+        wait_queue_t wait_queue{make_wait_queue(clock)};
+
+    public:
+        using ready_queue_type = ready_queue_t;
+        using wait_queue_type = wait_queue_t;
+        using clock_type = clock_t;
+
+        /**
+         * @brief 将handle插入到就绪队列中
+         *
+         * @param handle 要插入的协程柄
+         */
+        void ready_queue_push_back(::std::coroutine_handle<> handle) noexcept override { ready_queue.push_back(handle); }
+
+        /**
+         * @brief 将handle插入等待队列中，在等待至少ticks个系统时刻后唤醒
+         *
+         * @param handle 要插入的协程柄
+         * @param ticks 等待的系统时刻数
+         */
+        void wait_queue_push_back(::std::coroutine_handle<> handle, ::std::size_t ticks) noexcept override
+        {
+            wait_queue.push_back(handle, clock.now() + ticks);
+        }
+
+        /**
+         * @brief 分离任务并交由调度器执行，任务执行完成后自动释放协程帧
+         *
+         * @tparam allocator_t 分配器类型
+         * @param task 要执行的任务
+         */
+        template <::SoC::is_allocator allocator_t>
+        inline void spawn(::SoC::task_base<allocator_t> task) noexcept(::SoC::optional_noexcept)
+        {
+            auto handle{task.detach()};
+            handle.promise().detached = true;
+            ready_queue.push_back(handle);
+        }
+
+        /**
+         * @brief 判断调度器中是否没有待执行的协程
+         *
+         * @return 就绪队列和等待队列是否均为空
+         */
+        [[nodiscard]] inline bool empty() const noexcept { return ready_queue.empty() && wait_queue.empty(); }
+
+        /**
+         * @brief 获取就绪队列的引用
+         *
+         * @return 就绪队列的引用
+         */
+        [[nodiscard]] inline auto&& get_ready_queue(this auto&& self) noexcept
+        {
+            return ::std::forward_like<decltype(self)>(self.ready_queue);
+        }
+
+        /**
+         * @brief 获取等待队列的引用
+         *
+         * @return 等待队列的引用
+         */
+        [[nodiscard]] inline auto&& get_wait_queue(this auto&& self) noexcept
+        {
+            return ::std::forward_like<decltype(self)>(self.wait_queue);
+        }
+
+        /**
+         * @brief 唤醒所有到期的协程，然后执行一轮就绪队列
+         *
+         * @note 本轮执行中新加入就绪队列的协程将在下一轮执行，以免等待队列饥饿
+         */
+        inline void poll() noexcept(::SoC::optional_noexcept)
+        {
+            wait_queue.expire(clock.now(), [this](::std::coroutine_handle<> handle) { ready_queue.push_back(handle); });
+#pragma GCC unroll 0
+            for(auto cnt{ready_queue.size()}; cnt != 0; --cnt) { ready_queue.pop_front().resume(); }
+        }
+
+        /**
+         * @brief 持续执行协程，直到就绪队列和等待队列均为空
+         *
+         * @note 没有就绪协程时通过调度器时钟休眠到最早的等待协程到期，时钟可以提前返回
+         */
+        inline void run() noexcept(::SoC::optional_noexcept)
+        {
+#pragma GCC unroll 0
+            while(!empty())
+            {
+                poll();
+                if(!ready_queue.empty()) { continue; }
+                if(auto next_tick{wait_queue.next_tick()}; clock.now() < next_tick) { clock.sleep_until(next_tick); }
+            }
+        }
+    };
+
+    /**
+     * @brief 默认调度器类型，使用先进先出就绪队列和二叉堆等待队列
+     *
+     * @tparam ready_queue_size 就绪队列容量，必须是2的幂
+     * @tparam wait_queue_size 等待队列容量
+     */
+    template <::std::size_t ready_queue_size = 16, ::std::size_t wait_queue_size = 16>
+    using scheduler =
+        ::SoC::basic_scheduler<::SoC::fifo_ready_queue<ready_queue_size>, ::SoC::heap_wait_queue<wait_queue_size>>;
+
+    /**
+     * @brief 优先级调度器类型，使用多级优先级就绪队列和二叉堆等待队列
+     *
+     * @tparam level_cnt 优先级数量，不超过32
+     * @tparam level_size 每个优先级的队列容量，必须是2的幂
+     * @tparam wait_queue_size 等待队列容量
+     */
+    template <::std::size_t level_cnt = 8, ::std::size_t level_size = 8, ::std::size_t wait_queue_size = 16>
+    using priority_scheduler = ::SoC::basic_scheduler<::SoC::priority_ready_queue<level_cnt, level_size>,
+                                                      ::SoC::heap_wait_queue<wait_queue_size>>;
+
+    /**
+     * @brief 最早截止时刻优先调度器类型，使用EDF就绪队列和二叉堆等待队列
+     *
+     * @tparam ready_queue_size 就绪队列容量
+     * @tparam wait_queue_size 等待队列容量
+     * @tparam clock_t 调度器时钟类型
+     */
+    template <::std::size_t ready_queue_size = 16,
+              ::std::size_t wait_queue_size = 16,
+              ::SoC::is_scheduler_clock clock_t = ::SoC::systick_clock>
+    using edf_scheduler = ::SoC::basic_scheduler<::SoC::edf_ready_queue<ready_queue_size, clock_t>,
+                                                 ::SoC::heap_wait_queue<wait_queue_size>,
+                                                 clock_t>;
+
+    /**
+     * @brief 时间轮调度器类型，使用先进先出就绪队列和分层时间轮等待队列
+     *
+     * @tparam ready_queue_size 就绪队列容量，必须是2的幂
+     * @tparam timer_cnt 可同时等待的协程数量
+     * @tparam clock_t 调度器时钟类型，时间轮以其构造时的当前时刻为起点
+     */
+    template <::std::size_t ready_queue_size = 16,
+              ::std::size_t timer_cnt = 64,
+              ::SoC::is_scheduler_clock clock_t = ::SoC::systick_clock>
+    using wheel_scheduler =
+        ::SoC::basic_scheduler<::SoC::fifo_ready_queue<ready_queue_size>, ::SoC::timing_wheel<timer_cnt>, clock_t>;
+}  // namespace SoC
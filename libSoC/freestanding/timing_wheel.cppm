@@ -0,0 +1,355 @@
+/**
+ * @file timing_wheel.cppm
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief 独立的分层时间轮实现
+ *
+ * 本模块提供按系统时刻组织的分层时间轮，可作为协程调度器的等待队列
+ */
+
+export module SoC.freestanding:timing_wheel;
+import :utils;
+
+export namespace SoC
+{
+    namespace test
+    {
+        /// @see SoC::timing_wheel
+        extern "C++" template <::std::size_t node_cnt, ::std::size_t slot_shift, ::std::size_t level_cnt>
+        struct timing_wheel;
+    }  // namespace test
+
+    /**
+     * @brief 分层时间轮
+     *
+     * 每层有2^slot_shift个槽，定时器按目标时刻与当前时刻的最高不同位所在的层放置，因此插入和取消均为常数时间。
+     * 时间推进时仅在非空槽之间跳转，高层的槽在推进到其起始时刻时逐级下放到低层，第0层的槽在推进到该时刻时到期。
+     * 超出所有层范围的定时器放入溢出链表，在最高层回绕时重新放置。
+     * @tparam node_cnt 定时器节点数量，即可同时存在的定时器数量
+     * @tparam slot_shift 每层槽数量的左移量，不超过6以便使用64位占用位图
+     * @tparam level_cnt 层数
+     */
+    template <::std::size_t node_cnt, ::std::size_t slot_shift = 6, ::std::size_t level_cnt = 4>
+        requires (node_cnt >= 1 && node_cnt < 0xffff && slot_shift >= 1 && slot_shift <= 6 && level_cnt >= 1 &&
+                  slot_shift * level_cnt < 64)
+    struct timing_wheel
+    {
+        /// 定时器标识符
+        using timer_id = ::std::uint16_t;
+        /// 无效的定时器标识符
+        constexpr inline static timer_id invalid_timer_id{0xffff};
+
+    private:
+        friend struct ::SoC::test::timing_wheel<node_cnt, slot_shift, level_cnt>;
+
+        /// 每层的槽数量
+        constexpr inline static auto slot_cnt{1zu << slot_shift};
+        /// 槽索引掩码
+        constexpr inline static auto slot_mask{slot_cnt - 1};
+        /// 所有层覆盖的时刻位宽
+        constexpr inline static auto total_shift{slot_shift * level_cnt};
+        /// 溢出链表对应的槽索引
+        constexpr inline static ::std::uint16_t overflow_slot{slot_cnt * level_cnt};
+        /// 空闲节点的槽索引
+        constexpr inline static ::std::uint16_t free_slot{0xffff};
+
+        /**
+         * @brief 定时器节点，通过索引组成双向链表
+         *
+         */
+        struct node
+        {
+            /// 唤醒协程的目标系统时刻
+            ::std::uint64_t target_tick;
+            /// 等待的协程柄
+            ::std::coroutine_handle<> handle;
+            /// 上一个节点
+            timer_id prev;
+            /// 下一个节点，空闲节点使用该字段组成空闲链表
+            timer_id next;
+            /// 节点所在的槽索引
+            ::std::uint16_t slot;
+        };
+
+        /// 节点池
+        ::std::array<node, node_cnt> nodes{};
+        /// 各槽的链表头，最后一项为溢出链表
+        ::std::array<timer_id, slot_cnt * level_cnt + 1> slots{};
+        /// 各层的占用位图
+        ::std::array<::std::uint64_t, level_cnt> bitmaps{};
+        /// 空闲节点链表头
+        timer_id free_list{};
+        /// 正在使用的节点数量
+        ::std::size_t count{};
+        /// 下一个尚未处理的系统时刻
+        ::std::uint64_t current;
+
+        /**
+         * @brief 按目标时刻与当前时刻将节点放入对应的槽
+         *
+         * @param id 节点标识符
+         */
+        constexpr inline void link(timer_id id) noexcept
+        {
+            auto&& node{nodes[id]};
+            auto diff{node.target_tick ^ current};
+            auto level{diff == 0 ? 0zu : (::std::bit_width(diff) - 1) / slot_shift};
+            ::std::uint16_t slot{overflow_slot};
+            if(level < level_cnt) [[likely]]
+            {
+                auto index{(node.target_tick >> (level * slot_shift)) & slot_mask};
+                slot = static_cast<::std::uint16_t>(level * slot_cnt + index);
+                bitmaps[level] |= ::std::uint64_t{1} << index;
+            }
+            node.slot = slot;
+            node.prev = invalid_timer_id;
+            node.next = ::std::exchange(slots[slot], id);
+            if(node.next != invalid_timer_id) { nodes[node.next].prev = id; }
+        }
+
+        /**
+         * @brief 将节点从其所在的槽中移除
+         *
+         * @param id 节点标识符
+         */
+        constexpr inline void unlink(timer_id id) noexcept
+        {
+            auto&& [_, _, prev, next, slot]{nodes[id]};
+            if(prev != invalid_timer_id) { nodes[prev].next = next; }
+            else
+            {
+                slots[slot] = next;
+            }
+            if(next != invalid_timer_id) { nodes[next].prev = prev; }
+            if(slots[slot] == invalid_timer_id && slot != overflow_slot)
+            {
+                bitmaps[slot / slot_cnt] &= ~(::std::uint64_t{1} << (slot & slot_mask));
+            }
+        }
+
+        /**
+         * @brief 将节点归还空闲链表
+         *
+         * @param id 节点标识符
+         */
+        constexpr inline void free_node(timer_id id) noexcept
+        {
+            auto&& node{nodes[id]};
+            node.slot = free_slot;
+            node.next = ::std::exchange(free_list, id);
+            --count;
+        }
+
+        /**
+         * @brief 取出槽内的整条链表并清除占用位
+         *
+         * @param slot 槽索引
+         * @return 链表头
+         */
+        constexpr inline timer_id detach_slot(::std::size_t slot) noexcept
+        {
+            if(slot != overflow_slot) { bitmaps[slot / slot_cnt] &= ~(::std::uint64_t{1} << (slot & slot_mask)); }
+            return ::std::exchange(slots[slot], invalid_timer_id);
+        }
+
+        /**
+         * @brief 将槽内的节点按当前时刻重新放置到低层
+         *
+         * @param slot 槽索引
+         */
+        constexpr inline void cascade(::std::size_t slot) noexcept
+        {
+#pragma GCC unroll 0
+            for(auto id{detach_slot(slot)}; id != invalid_timer_id;)
+            {
+                auto next{nodes[id].next};
+                link(id);
+                id = next;
+            }
+        }
+
+        /**
+         * @brief 获取下一个需要处理的系统时刻，即最近的到期或下放时刻
+         *
+         * @return 下一个需要处理的系统时刻，没有定时器时为最大值
+         */
+        [[nodiscard]] constexpr inline ::std::uint64_t next_event() const noexcept
+        {
+            auto result{::std::numeric_limits<::std::uint64_t>::max()};
+            for(auto level{0zu}; level != level_cnt; ++level)
+            {
+                auto shift{level * slot_shift};
+                auto index{(current >> shift) & slot_mask};
+                // 当前时刻恰为当前槽的起始时刻时当前槽尚未处理，否则当前槽已经处理，只需查找之后的槽
+                auto low_mask{(::std::uint64_t{1} << shift) - 1};
+                auto search_mask{(current & low_mask) == 0 ? ~::std::uint64_t{} << index : ~::std::uint64_t{1} << index};
+                auto bitmap{bitmaps[level] & search_mask};
+                if(bitmap != 0)
+                {
+                    auto base{current & ~((::std::uint64_t{1} << (shift + slot_shift)) - 1)};
+                    result = ::std::min(result, base | (static_cast<::std::uint64_t>(::std::countr_zero(bitmap)) << shift));
+                }
+            }
+            if(slots[overflow_slot] != invalid_timer_id)
+            {
+                // 向上对齐到最高层的回绕时刻
+                constexpr auto total_mask{(::std::uint64_t{1} << total_shift) - 1};
+                result = ::std::min(result, (current + total_mask) & ~total_mask);
+            }
+            return result;
+        }
+
+    public:
+        /**
+         * @brief 构造时间轮，以start_tick为起点
+         *
+         * @param start_tick 起始时刻，必须与之后插入和推进时使用的时钟一致
+         * @note 早于起始时刻的定时器视为在起始时刻到期，因此与调度器配合时应使用调度器时钟的当前时刻
+         */
+        explicit constexpr inline timing_wheel(::std::uint64_t start_tick) noexcept : current{start_tick}
+        {
+            slots.fill(invalid_timer_id);
+            for(auto id{0zu}; id != node_cnt; ++id)
+            {
+                nodes[id].next = static_cast<timer_id>(id + 1);
+                nodes[id].slot = free_slot;
+            }
+            nodes.back().next = invalid_timer_id;
+        }
+
+        /**
+         * @brief 构造时间轮，以当前系统时刻为起点
+         *
+         */
+        inline timing_wheel() noexcept(::SoC::optional_noexcept) : timing_wheel{::SoC::get_systick()} {}
+
+        /**
+         * @brief 插入定时器
+         *
+         * @param handle 等待的协程柄
+         * @param target_tick 唤醒协程的目标系统时刻，早于当前时刻时视为当前时刻
+         * @return 定时器标识符，可用于取消定时器
+         */
+        constexpr inline timer_id insert(::std::coroutine_handle<> handle, ::std::uint64_t target_tick) noexcept(
+            ::SoC::optional_noexcept)
+        {
+            using namespace ::std::string_view_literals;
+            ::SoC::always_check(free_list != invalid_timer_id, "时间轮定时器节点已用尽"sv);
+            auto id{free_list};
+            auto&& node{nodes[id]};
+            free_list = node.next;
+            node.target_tick = ::std::max(target_tick, current);
+            node.handle = handle;
+            link(id);
+            ++count;
+            return id;
+        }
+
+        /**
+         * @brief 取消尚未到期的定时器
+         *
+         * @param id 定时器标识符
+         */
+        constexpr inline void cancel(timer_id id) noexcept(::SoC::optional_noexcept)
+        {
+            if constexpr(::SoC::use_full_assert)
+            {
+                using namespace ::std::string_view_literals;
+                ::SoC::assert(id < node_cnt && nodes[id].slot != free_slot, "要取消的定时器不存在或已到期"sv);
+            }
+            unlink(id);
+            free_node(id);
+        }
+
+        /**
+         * @brief 将协程柄插入时间轮
+         *
+         * @param handle 要插入的协程柄
+         * @param target_tick 唤醒协程的目标系统时刻
+         */
+        constexpr inline void push_back(::std::coroutine_handle<> handle, ::std::uint64_t target_tick) noexcept(
+            ::SoC::optional_noexcept)
+        {
+            insert(handle, target_tick);
+        }
+
+        /**
+         * @brief 获取下一次需要推进时间轮的系统时刻
+         *
+         * @return 不晚于最早到期时刻的系统时刻，时间轮为空时为最大值
+         * @note 返回值可能是高层槽的下放时刻，此时在该时刻调用expire不会唤醒协程
+         */
+        [[nodiscard]] constexpr inline ::std::uint64_t next_tick() const noexcept
+        {
+            return count == 0 ? ::std::numeric_limits<::std::uint64_t>::max() : next_event();
+        }
+
+        /**
+         * @brief 判断时间轮是否为空
+         *
+         * @return 时间轮是否为空
+         */
+        [[nodiscard]] constexpr inline bool empty() const noexcept { return count == 0; }
+
+        /**
+         * @brief 获取时间轮中的定时器数量
+         *
+         * @return 定时器数量
+         */
+        [[nodiscard]] constexpr inline ::std::size_t size() const noexcept { return count; }
+
+        /**
+         * @brief 获取下一个尚未处理的系统时刻
+         *
+         * @return 下一个尚未处理的系统时刻
+         */
+        [[nodiscard]] constexpr inline ::std::uint64_t get_current_tick() const noexcept { return current; }
+
+        /**
+         * @brief 推进时间轮至now时刻，取出所有在now时刻及以前到期的协程
+         *
+         * @param now 当前系统时刻
+         * @param callback 对每个到期的协程柄调用的回调函数
+         */
+        constexpr inline void expire(::std::uint64_t now, auto&& callback) noexcept(::SoC::optional_noexcept)
+        {
+#pragma GCC unroll 0
+            while(count != 0)
+            {
+                auto next{next_event()};
+                if(next > now) { break; }
+                current = next;
+
+                // 从高层到低层依次下放当前时刻对应的槽
+                if(slots[overflow_slot] != invalid_timer_id && (current & ((::std::uint64_t{1} << total_shift) - 1)) == 0)
+                {
+                    cascade(overflow_slot);
+                }
+                for(auto level{level_cnt - 1}; level != 0; --level)
+                {
+                    auto shift{level * slot_shift};
+                    auto index{(current >> shift) & slot_mask};
+                    auto low_mask{(::std::uint64_t{1} << shift) - 1};
+                    if((current & low_mask) == 0 && (bitmaps[level] & (::std::uint64_t{1} << index)) != 0)
+                    {
+                        cascade(level * slot_cnt + index);
+                    }
+                }
+
+                // 第0层当前槽内的定时器全部到期
+#pragma GCC unroll 0
+                for(auto id{detach_slot(current & slot_mask)}; id != invalid_timer_id;)
+                {
+                    auto&& node{nodes[id]};
+                    auto next_id{node.next};
+                    auto handle{node.handle};
+                    free_node(id);
+                    callback(handle);
+                    id = next_id;
+                }
+                ++current;
+            }
+            // 此后直到下一个需要处理的时刻都没有定时器，可以直接推进
+            current = ::std::max(current, now + 1);
+        }
+    };
+}  // namespace SoC
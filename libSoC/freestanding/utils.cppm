@@ -90,6 +90,22 @@ export namespace SoC
     /// 是否在单元测试中
     constexpr inline auto in_unit_test{false};
 #endif
+
+#ifdef SOC_HEAP_STATISTICS
+    /// 是否记录堆统计信息
+    constexpr inline auto use_heap_statistics{true};
+#else
+    /// 是否记录堆统计信息
+    constexpr inline auto use_heap_statistics{false};
+#endif
+
+#ifdef SOC_HEAP_TRACE
+    /// 是否支持记录堆跟踪事件
+    constexpr inline auto use_heap_trace{true};
+#else
+    /// 是否支持记录堆跟踪事件
+    constexpr inline auto use_heap_trace{false};
+#endif
 }  // namespace SoC
 
 namespace SoC
@@ -339,6 +355,45 @@ export namespace SoC
      * @note 根据具体的平台进行实现，嵌入式下可实现为等待中断发生，宿主平台下可实现为std::this_thread::yield()
      */
     extern "C++" void yield_cpu() noexcept(::SoC::optional_noexcept);
+
+    /**
+     * @brief 进入临界区，屏蔽所有可能访问共享数据的中断
+     *
+     * @return 进入临界区前的状态，退出临界区时用于恢复
+     * @note 根据具体的平台进行实现，嵌入式下可实现为提升BASEPRI，宿主平台下可实现为自旋锁，需要支持嵌套
+     */
+    extern "C++" ::std::uintptr_t enter_critical_section() noexcept;
+
+    /**
+     * @brief 退出临界区，恢复进入临界区前的状态
+     *
+     * @param state 进入临界区时返回的状态
+     */
+    extern "C++" void exit_critical_section(::std::uintptr_t state) noexcept;
+
+    /**
+     * @brief 临界区守卫，构造时进入临界区，析构时退出临界区
+     *
+     */
+    struct critical_section_guard
+    {
+    private:
+        ::std::uintptr_t state;
+
+    public:
+        [[using gnu: always_inline, artificial]] inline critical_section_guard() noexcept :
+            state{::SoC::enter_critical_section()}
+        {
+        }
+
+        [[using gnu: always_inline, artificial]] inline ~critical_section_guard() noexcept
+        {
+            ::SoC::exit_critical_section(state);
+        }
+
+        inline critical_section_guard(const critical_section_guard&) noexcept = delete;
+        inline critical_section_guard& operator= (const critical_section_guard&) noexcept = delete;
+    };
 }  // namespace SoC
 
 export namespace SoC
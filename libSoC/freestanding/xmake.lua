@@ -3,6 +3,15 @@ if is_current_mode_support_unit_test() then
     test_table["unit_test"] = function ()
         add_deps("SoC.std.unit_test")
         add_defines("SOC_IN_UNIT_TEST", {public = true})
+        -- 堆统计信息默认不编译，仅在单元测试中启用以便覆盖
+        add_defines("SOC_HEAP_STATISTICS", {public = true})
+        -- 跟踪事件需要平台提供get_systick，因此仅在单元测试中启用
+        add_defines("SOC_HEAP_TRACE", {public = true})
+    end
+    -- 宿主平台工具使用与目标平台相同的非虚堆实现，不启用全部断言和sanitizer，以便测量真实性能
+    test_table["tool"] = function ()
+        add_deps("SoC.std.tool")
+        set_values("stm32_pc.uninstrumented", true)
     end
 end
 if is_current_mode_support_fuzzer() then
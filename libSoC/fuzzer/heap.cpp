@@ -26,15 +26,23 @@ namespace SoC::test
             auto end{metadata.end()};
             ::std::size_t using_page_num{};
             ::std::size_t free_page_num{};
+            ::std::size_t unsplit_free_page_num{};
 
             // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
             auto data_address{reinterpret_cast<::std::uintptr_t>(data)};
             for(auto ptr{begin}; ptr != end;)
             {
-                auto&& [_, free_block_list, used_block, block_size_shift]{*ptr};
+                auto&& [_, _, free_block_list, used_block, block_size_shift, _]{*ptr};
                 auto max_block_num{1zu << (page_shift - block_size_shift)};
                 ::SoC::assert(used_block != max_block_num || free_block_list == nullptr,
                               "页使用计数为max_block_num，但其空闲块链表不为空"sv);
+                auto page_index{static_cast<::std::size_t>(ptr - begin)};
+                ::SoC::assert(test_bit(get_free_page_bitmap(), page_index) == (used_block == 0), "页空闲位图与使用计数不一致"sv);
+                if(block_size_shift != page_shift)
+                {
+                    auto is_empty{test_bit(get_empty_page_bitmap(block_size_shift - min_block_shift), page_index)};
+                    ::SoC::assert(is_empty == (used_block == 0), "空页位图与使用计数不一致"sv);
+                }
 
                 if(used_block == 0)
                 {
@@ -44,6 +52,7 @@ namespace SoC::test
                         auto* expected_free_block_list{reinterpret_cast<void*>(data_address + index * page_size)};
                         ::SoC::assert(free_block_list == expected_free_block_list, "未分块页的空闲块链表指针与预期不符"sv);
                         ::SoC::assert(free_block_list->next == nullptr, "未分块页的空闲块链表下一个指针不为空"sv);
+                        ++unsplit_free_page_num;
                     }
                     ++ptr;
                     ++free_page_num;
@@ -75,9 +84,11 @@ namespace SoC::test
                     auto continuous_pages{static_cast<::std::ptrdiff_t>(actual_size / page_size)};
                     for(auto i{0z}; i != continuous_pages; ++i)
                     {
-                        auto&& [_, free_block_list, used_block, block_size_shift]{*(ptr + i)};
+                        auto&& [_, _, free_block_list, used_block, block_size_shift, _]{*(ptr + i)};
                         ::SoC::assert(used_block == 1, "已按页分配分配的页面中使用计数不为1"sv);
                         ::SoC::assert(block_size_shift == page_shift, "已按页分配分配的页面中块大小不为页大小"sv);
+                        ::SoC::assert(!test_bit(get_free_page_bitmap(), page_index + static_cast<::std::size_t>(i)),
+                                      "已按页分配的页面在页空闲位图中被标记为空闲"sv);
                     }
                     ptr += continuous_pages;
                     using_page_num += continuous_pages;
@@ -86,6 +97,24 @@ namespace SoC::test
             }
             // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
 
+            // 伙伴系统中的页块应当完全由未分块的空闲页组成，且覆盖所有未分块的空闲页
+            ::std::size_t free_run_page_num{};
+            for(auto&& [order, head]: ::std::views::zip(::std::views::iota(0zu), free_run_list))
+            {
+                for(auto* page{head}; page != nullptr; page = page->next_page)
+                {
+                    ::SoC::assert(page->order == order, "伙伴系统中页块的阶数与所在链表不一致"sv);
+                    auto index{static_cast<::std::size_t>(page - metadata.data())};
+                    ::SoC::assert(index % (1zu << order) == 0, "伙伴系统中页块首页未对齐到页块大小"sv);
+                    for(auto&& [_, _, _, used_block, block_size_shift, _]: metadata.subspan(index, 1zu << order))
+                    {
+                        ::SoC::assert(used_block == 0 && block_size_shift == page_shift, "伙伴系统中页块包含非空闲页"sv);
+                    }
+                    free_run_page_num += 1zu << order;
+                }
+            }
+            ::SoC::assert(free_run_page_num == unsplit_free_page_num, "伙伴系统中的页数与未分块的空闲页数不一致"sv);
+
             ::std::erase_if(block_size_counter, [](const auto& pair) static noexcept { return pair.second == 0; });
             ::SoC::assert(heap_status_counter == block_size_counter, "堆状态计数器与实际分配的内存块大小计数器不一致"sv);
             ::SoC::assert(using_page_num == get_using_pages(), "已分配页面数与get_using_pages返回值不一致"sv);
@@ -589,6 +589,35 @@ export namespace SoC
          */
         void read(void* begin, void* end) noexcept;
 
+        /**
+         * @brief 配置内存到外设的数据传输，并使能dma数据流
+         *
+         * @tparam type 元素类型
+         * @tparam capability 缓冲区的访问能力，仅CPU可访问的缓冲区在编译期被拒绝
+         * @param buffer 带访问能力标记的缓冲区
+         */
+        template <typename type, ::SoC::memory_capability capability>
+        inline void write(::SoC::memory_span<type, capability> buffer) noexcept
+        {
+            static_assert(capability == ::SoC::memory_capability::dma, "dma无法访问仅CPU可访问的内存，如ccmram");
+            write(buffer.data(), buffer.data() + buffer.size());
+        }
+
+        /**
+         * @brief 配置外设到内存的数据传输，并使能dma数据流
+         *
+         * @tparam type 元素类型
+         * @tparam capability 缓冲区的访问能力，仅CPU可访问的缓冲区在编译期被拒绝
+         * @param buffer 带访问能力标记的缓冲区
+         */
+        template <typename type, ::SoC::memory_capability capability>
+            requires (!::std::is_const_v<type>)
+        inline void read(::SoC::memory_span<type, capability> buffer) noexcept
+        {
+            static_assert(capability == ::SoC::memory_capability::dma, "dma无法访问仅CPU可访问的内存，如ccmram");
+            read(buffer.data(), buffer.data() + buffer.size());
+        }
+
         /**
          * @brief 获取传输完成标记
          *
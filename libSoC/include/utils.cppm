@@ -83,6 +83,14 @@ export namespace SoC
          */
         ::std::uint64_t operator++ () noexcept;
 
+        /**
+         * @brief 将系统时刻增加ticks
+         *
+         * @param ticks 要增加的系统时刻数
+         * @return 增加后的系统时刻
+         */
+        ::std::uint64_t operator+= (::std::uint64_t ticks) noexcept;
+
         /**
          * @brief 读取系统时刻
          *
@@ -96,6 +104,37 @@ export namespace SoC
          */
         operator ::std::uint64_t () const noexcept;
     } inline constinit systick_v{};
+
+    /**
+     * @brief 无节拍调度器时钟，满足SoC::is_scheduler_clock
+     *
+     * 空闲时将SysTick重装载值设置为到最早截止时刻的时长后执行WFI，唤醒后根据实际经过的时间修正systick_v，
+     * 避免等待期间每个系统时刻都产生中断
+     */
+    struct tickless_clock
+    {
+        /**
+         * @brief 获取当前系统时刻
+         *
+         * @return 当前系统时刻
+         */
+        [[nodiscard]] inline ::std::uint64_t now() const noexcept { return ::SoC::systick_v; }
+
+        /**
+         * @brief 休眠直到target_tick或被其他中断唤醒
+         *
+         * @param target_tick 目标系统时刻
+         * @note 被其他中断提前唤醒时，按已计数的周期补上经过的系统时刻，并保持系统时刻边界的相位
+         */
+        void sleep_until(::std::uint64_t target_tick) const noexcept;
+    };
+
+    /**
+     * @brief 临界区屏蔽的中断优先级，编码后的优先级数值不小于该值的中断在临界区中被屏蔽
+     *
+     * @note 优先级更高的中断不受临界区影响，因此不可访问临界区保护的数据，如SoC::interrupt_safe_heap
+     */
+    constexpr inline ::std::uint32_t critical_section_priority{0b0100};
 }  // namespace SoC
 
 namespace SoC
@@ -127,8 +166,8 @@ namespace SoC
      *
      * @return ccmram堆
      */
-    export inline ::SoC::heap make_ccmram_heap() noexcept
+    export inline ::SoC::ccmram_heap make_ccmram_heap() noexcept
     {
-        return ::SoC::heap{auto(::SoC::_ccmram_heap_start), auto(::SoC::_ccmram_heap_end)};
+        return ::SoC::ccmram_heap{auto(::SoC::_ccmram_heap_start), auto(::SoC::_ccmram_heap_end)};
     }
 }  // namespace SoC
@@ -206,7 +206,11 @@ namespace SoC
     void ::SoC::dma_stream::set_memory_address(const void* begin) const noexcept
     {
         auto num{::SoC::bit_cast<::std::uintptr_t>(begin)};
-        if constexpr(::SoC::use_full_assert) { ::SoC::assert(check_aligned(num), "缓冲区首地址不满足对齐要求"sv); }
+        if constexpr(::SoC::use_full_assert)
+        {
+            ::SoC::assert(check_aligned(num), "缓冲区首地址不满足对齐要求"sv);
+            ::SoC::assert(num < CCMDATARAM_BASE || num > CCMDATARAM_END, "dma无法访问ccmram中的缓冲区"sv);
+        }
         ::LL_DMA_SetMemoryAddress(dma_ptr, ::SoC::to_underlying(stream), num);
     }
 
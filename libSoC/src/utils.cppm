@@ -14,20 +14,140 @@ namespace SoC
 
     ::SoC::systick_t::operator ::std::uint64_t () const noexcept { return load(); }
 
-    ::std::uint64_t(::SoC::systick_t::operator++)() noexcept
+    ::std::uint64_t(::SoC::systick_t::operator+=)(::std::uint64_t ticks) noexcept
     {
-        auto new_index{index.load(::std::memory_order_relaxed) ^ 1zu};
-        auto result{systick[new_index] += 2};
+        auto old_index{index.load(::std::memory_order_relaxed)};
+        auto new_index{old_index ^ 1zu};
+        auto result{systick[new_index] = systick[old_index] + ticks};
         ::std::atomic_signal_fence(::std::memory_order_release);
         index.store(new_index, ::std::memory_order_relaxed);
         return result;
     }
 
-    extern "C" void SysTick_Handler() noexcept { ++::SoC::systick_v; }
+    ::std::uint64_t(::SoC::systick_t::operator++)() noexcept { return *this += 1; }
+}  // namespace SoC
+
+namespace SoC::detail
+{
+    /// 每个系统时刻对应的SysTick周期数
+    constexpr auto systick_cycles{static_cast<::std::uint32_t>(::SoC::systick{1}.duration_cast<::SoC::cycle>().rep)};
+    /// SysTick下一次中断时经过的系统时刻数
+    constinit ::std::uint32_t systick_period{1};
+    /// SysTick重装载值是否被无节拍休眠修改，修改后下一次中断需要恢复为每个系统时刻中断一次
+    constinit bool systick_reprogrammed{};
+
+    /**
+     * @brief 恢复SysTick为每个系统时刻中断一次
+     *
+     */
+    inline void restore_systick_period() noexcept
+    {
+        SysTick->LOAD = systick_cycles - 1;
+        SysTick->VAL = 0;
+        systick_period = 1;
+        systick_reprogrammed = false;
+    }
+
+    /**
+     * @brief 重新编程SysTick，使其在cycles个周期后中断，并在中断时补上period个系统时刻
+     *
+     * @param cycles 到下一次中断的周期数
+     * @param period 下一次中断时经过的系统时刻数
+     */
+    inline void reprogram_systick(::std::uint32_t cycles, ::std::uint32_t period) noexcept
+    {
+        SysTick->LOAD = cycles - 1;
+        // 写VAL会清零计数器和COUNTFLAG，下一个时钟从LOAD开始计数
+        SysTick->VAL = 0;
+        systick_period = period;
+        systick_reprogrammed = true;
+    }
+}  // namespace SoC::detail
+
+namespace SoC
+{
+    extern "C" void SysTick_Handler() noexcept
+    {
+        using namespace ::SoC::detail;
+        if(!systick_reprogrammed) [[likely]] { ++::SoC::systick_v; }
+        else
+        {
+            // 无节拍休眠到期或提前唤醒后的相位修正周期结束，补上对应的系统时刻
+            ::SoC::systick_v += systick_period;
+            restore_systick_period();
+        }
+    }
+
+    void ::SoC::tickless_clock::sleep_until(::std::uint64_t target_tick) const noexcept
+    {
+        using namespace ::SoC::detail;
+        // SysTick重装载值为24位，限制单次休眠的最大系统时刻数
+        constexpr auto max_ticks{(SysTick_LOAD_RELOAD_Msk + 1) / systick_cycles};
+
+        // 关闭中断后WFI仍可被挂起的中断唤醒，且重新编程SysTick期间不会丢失系统时刻
+        ::__disable_irq();
+        auto now{::SoC::systick_v.load()};
+        // 已有挂起的SysTick中断、SysTick已被重新编程或不足两个系统时刻时，无需重新编程SysTick
+        if((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0 || systick_reprogrammed || target_tick <= now + 1)
+        {
+            ::SoC::wait_for_interpret();
+            ::__enable_irq();
+            return;
+        }
+
+        auto ticks{static_cast<::std::uint32_t>(::std::min<::std::uint64_t>(target_tick - now, max_ticks))};
+        // 当前系统时刻剩余的周期数，保证唤醒时刻与系统时刻边界对齐
+        auto remain{SysTick->VAL};
+        // 清除之前遗留的COUNTFLAG，此后COUNTFLAG置位表示长周期已经到期
+        static_cast<void>(SysTick->CTRL);
+        auto period_cycles{remain + (ticks - 1) * systick_cycles};
+        reprogram_systick(period_cycles, ticks);
+        ::SoC::wait_for_interpret();
+
+        // 暂停计数，保证读取的VAL与COUNTFLAG一致；第二次读取CTRL用于捕获第一次读取与暂停之间发生的回绕
+        auto ctrl{SysTick->CTRL};
+        SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+        auto value{SysTick->VAL};
+        auto expired{((ctrl | SysTick->CTRL) & SysTick_CTRL_COUNTFLAG_Msk) != 0};
+        if(!expired)
+        {
+            // 被其他中断提前唤醒，VAL为0表示计数器尚未从LOAD开始计数
+            auto elapsed{value == 0 ? 0 : period_cycles - value};
+            auto [elapsed_ticks, next_tick_cycles]{::SoC::detail::get_tickless_wakeup(remain, elapsed, systick_cycles)};
+            if(next_tick_cycles == 1)
+            {
+                // LOAD为0时SysTick不产生中断，距边界仅剩一个周期时直接计入该系统时刻
+                ++elapsed_ticks;
+                restore_systick_period();
+            }
+            else
+            {
+                // 下一次中断对齐到原系统时刻边界，中断后恢复为每个系统时刻中断一次
+                reprogram_systick(next_tick_cycles, 1);
+            }
+            ::SoC::systick_v += elapsed_ticks;
+        }
+        // 到期时SysTick中断已挂起，开中断后由SysTick_Handler补上系统时刻
+        SysTick->CTRL = ctrl | SysTick_CTRL_ENABLE_Msk;
+        ::__enable_irq();
+    }
 
     extern "C++" void yield_cpu() noexcept(::SoC::optional_noexcept) { ::SoC::wait_for_interpret(); }
 
     extern "C++" ::std::uint64_t get_systick() noexcept(::SoC::optional_noexcept) { return ::SoC::systick_v; }
+
+    extern "C++" ::std::uintptr_t enter_critical_section() noexcept
+    {
+        auto state{::__get_BASEPRI()};
+        // BASEPRI_MAX只能提升屏蔽优先级，因此嵌套进入临界区时不会解除外层的屏蔽
+        ::__set_BASEPRI_MAX(::SoC::critical_section_priority << (8 - __NVIC_PRIO_BITS));
+        return state;
+    }
+
+    extern "C++" void exit_critical_section(::std::uintptr_t state) noexcept
+    {
+        ::__set_BASEPRI(static_cast<::std::uint32_t>(state));
+    }
 }  // namespace SoC
 
 namespace SoC::detail
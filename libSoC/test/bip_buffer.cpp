@@ -0,0 +1,144 @@
+/**
+ * @file bip_buffer.cpp
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief 测试双分区缓冲区
+ */
+
+import "test_framework.hpp";
+import SoC.unit_test;
+
+using namespace ::std::string_view_literals;
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define REGISTER_TEST_CASE(NAME) TEST_CASE("bip_buffer/" NAME)
+
+namespace SoC::test
+{
+    extern "C++" template <typename type, ::std::size_t buffer_size, ::SoC::memory_capability capability_v>
+    struct bip_buffer : ::SoC::bip_buffer<type, buffer_size, capability_v>
+    {
+        using base_t = ::SoC::bip_buffer<type, buffer_size, capability_v>;
+        using base_t::base_t;
+        using base_t::buffer;
+    };
+}  // namespace SoC::test
+
+namespace
+{
+    using bip_buffer_t = ::SoC::test::bip_buffer<char, 8, ::SoC::memory_capability::dma>;
+
+    /**
+     * @brief 预留n个元素，写入str并提交
+     *
+     * @param buffer 双分区缓冲区
+     * @param n 预留的元素数
+     * @param str 要写入的内容
+     * @return 预留区域相对缓冲区首地址的偏移量
+     */
+    ::std::ptrdiff_t reserve_and_commit(::bip_buffer_t& buffer, ::std::size_t n, ::std::string_view str)
+    {
+        auto region{buffer.reserve(n)};
+        REQUIRE_EQ(region.size(), n);
+        ::std::ranges::copy(str, region.begin());
+        buffer.commit(str.size());
+        return region.data() - &buffer.buffer[0].value;
+    }
+}  // namespace
+
+/// @test 测试双分区缓冲区
+TEST_SUITE("bip_buffer" * ::doctest::description{"测试双分区缓冲区"})
+{
+    /// @test 测试预留、提交、读取和释放
+    REGISTER_TEST_CASE("reserve_commit" * ::doctest::description{"测试预留、提交、读取和释放"})
+    {
+        ::bip_buffer_t buffer{};
+        CHECK(buffer.empty());
+        CHECK(buffer.read().empty());
+        CHECK(buffer.reserve(0).empty());
+        CHECK(buffer.reserve(9).empty());
+
+        CHECK_EQ(::reserve_and_commit(buffer, 3, "abc"), 0);
+        CHECK_EQ(::reserve_and_commit(buffer, 4, "de"), 3);
+        CHECK_EQ(buffer.size(), 5);
+        CHECK(::std::ranges::equal(buffer.read(), "abcde"sv));
+
+        // 未提交的预留不影响已提交的内容
+        CHECK_EQ(buffer.reserve(3).size(), 3);
+        buffer.commit(0);
+        CHECK_EQ(buffer.size(), 5);
+
+        CHECK_THROWS_WITH_AS_MESSAGE(buffer.commit(1),
+                                     ::doctest::Contains{"提交的元素数超过预留区域"},
+                                     ::SoC::assert_failed_exception,
+                                     "没有预留区域时提交应断言失败"sv);
+        CHECK_THROWS_WITH_AS_MESSAGE(buffer.release(6),
+                                     ::doctest::Contains{"释放的元素数超过可读区域"},
+                                     ::SoC::assert_failed_exception,
+                                     "释放的元素超过可读区域应断言失败"sv);
+
+        buffer.release(5);
+        CHECK(buffer.empty());
+        // 缓冲区清空后从头开始分配
+        CHECK_EQ(buffer.reserve(8).size(), 8);
+    }
+
+    /// @test 测试末尾空间不足时在开头开启分区B，区域不会跨越缓冲区末尾
+    REGISTER_TEST_CASE("wrap" * ::doctest::description{"测试末尾空间不足时在开头开启分区B，区域不会跨越缓冲区末尾"})
+    {
+        ::bip_buffer_t buffer{};
+        CHECK_EQ(::reserve_and_commit(buffer, 6, "abcdef"), 0);
+        buffer.release(4);
+        // 末尾仅剩2个元素，3个元素的报文整体放到开头
+        CHECK_EQ(::reserve_and_commit(buffer, 3, "ghi"), 0);
+        CHECK_EQ(buffer.size(), 5);
+        CHECK(::std::ranges::equal(buffer.read(), "ef"sv));
+        // 分区B开启后只能在分区B之后写入，剩余空间不足
+        CHECK(buffer.reserve(2).empty());
+        CHECK_EQ(::reserve_and_commit(buffer, 1, "j"), 3);
+
+        buffer.release(2);
+        // 分区A释放完后分区B成为新的分区A
+        CHECK(::std::ranges::equal(buffer.read(), "ghij"sv));
+        CHECK_EQ(::reserve_and_commit(buffer, 4, "klmn"), 4);
+        CHECK(::std::ranges::equal(buffer.read(), "ghijklmn"sv));
+        CHECK(buffer.reserve(1).empty());
+
+        buffer.clear();
+        CHECK(buffer.empty());
+        CHECK_EQ(buffer.reserve(8).size(), 8);
+    }
+
+    /// @test 测试预留区域和可读区域按缓冲区所在内存的访问能力标记
+    REGISTER_TEST_CASE("capability" * ::doctest::description{"测试预留区域和可读区域按缓冲区所在内存的访问能力标记"})
+    {
+        ::bip_buffer_t buffer{};
+        // 默认位于可被DMA访问的内存中，可读区域可直接交给dma_stream::write
+        CHECK(::std::same_as<::SoC::bip_buffer<char, 8>::read_region, ::SoC::dma_span<const char>>);
+        CHECK(::std::same_as<decltype(buffer.reserve(1)), ::SoC::dma_span<char>>);
+        CHECK(::std::same_as<decltype(buffer.read()), ::SoC::dma_span<const char>>);
+        CHECK_EQ(::reserve_and_commit(buffer, 3, "abc"), 0);
+        ::SoC::dma_span<const char> region{buffer.read()};
+        CHECK(::std::ranges::equal(region, "abc"sv));
+
+        // 位于ccmram中的缓冲区的区域被标记为仅CPU可访问，dma_stream::write在编译期拒绝
+        ::SoC::bip_buffer<char, 8, ::SoC::memory_capability::cpu_only> ccmram_buffer{};
+        CHECK_EQ(ccmram_buffer.capability, ::SoC::memory_capability::cpu_only);
+        CHECK_EQ(ccmram_buffer.reserve(2).capability, ::SoC::memory_capability::cpu_only);
+        CHECK_EQ(ccmram_buffer.read().capability, ::SoC::memory_capability::cpu_only);
+        CHECK(ccmram_buffer.reserve(9).empty());
+    }
+
+    /// @test 测试在预留与提交之间释放全部已提交的元素
+    REGISTER_TEST_CASE("release_before_commit" * ::doctest::description{"测试在预留与提交之间释放全部已提交的元素"})
+    {
+        ::bip_buffer_t buffer{};
+        CHECK_EQ(::reserve_and_commit(buffer, 4, "abcd"), 0);
+        auto region{buffer.reserve(2)};
+        REQUIRE_EQ(region.size(), 2);
+        ::std::ranges::copy("ef"sv, region.begin());
+        // 例如在写入新报文期间，上一条报文发送完成并被释放
+        buffer.release(4);
+        buffer.commit(2);
+        CHECK(::std::ranges::equal(buffer.read(), "ef"sv));
+        CHECK_EQ(buffer.read().data(), region.data());
+    }
+}
@@ -0,0 +1,108 @@
+/**
+ * @file frame_cache_allocator.cpp
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief 测试协程帧回收分配器
+ */
+
+import "test_framework.hpp";
+import SoC.unit_test;
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define REGISTER_TEST_CASE(NAME) TEST_CASE("frame_cache_allocator/" NAME)
+
+namespace
+{
+    using allocator_t = ::SoC::frame_cache_allocator<::SoC::std_allocator, 2>;
+
+    /**
+     * @brief 清空缓存并重置统计信息
+     *
+     */
+    void reset() noexcept
+    {
+        ::allocator_t::release();
+        ::allocator_t::reset_counter();
+        ::SoC::std_allocator::reset();
+    }
+}  // namespace
+
+/// @test 测试协程帧回收分配器
+TEST_SUITE("frame_cache_allocator" * ::doctest::description{"测试协程帧回收分配器"})
+{
+    /// @test 测试分配器满足静态分配器约束
+    REGISTER_TEST_CASE("concept" * ::doctest::description{"测试分配器满足静态分配器约束"})
+    {
+        CHECK(::SoC::is_static_allocator<::allocator_t>);
+        CHECK(::std::is_empty_v<::allocator_t>);
+    }
+
+    /// @test 测试释放的内存块按大小复用
+    REGISTER_TEST_CASE("reuse" * ::doctest::description{"测试释放的内存块按大小复用"})
+    {
+        ::reset();
+        auto ptr1{::allocator_t::allocate(64)};
+        auto ptr2{::allocator_t::allocate(64)};
+        CHECK_EQ(::allocator_t::get_miss_cnt(), 2);
+        ::allocator_t::deallocate(ptr1, 64);
+        ::allocator_t::deallocate(ptr2, 64);
+        CHECK_EQ(::SoC::std_allocator::deallocate_cnt, 0);
+
+        // 后进先出复用
+        CHECK_EQ(::allocator_t::allocate(64), ptr2);
+        CHECK_EQ(::allocator_t::allocate(64), ptr1);
+        CHECK_EQ(::allocator_t::get_hit_cnt(), 2);
+
+        // 大小不同时不复用
+        auto ptr3{::allocator_t::allocate(32)};
+        CHECK_EQ(::allocator_t::get_miss_cnt(), 3);
+        ::allocator_t::deallocate(ptr1, 64);
+        ::allocator_t::deallocate(ptr2, 64);
+        ::allocator_t::deallocate(ptr3, 32);
+        CHECK_EQ(::SoC::std_allocator::allocate_cnt, 3);
+
+        ::allocator_t::release();
+        CHECK_EQ(::SoC::std_allocator::deallocate_cnt, 3);
+        // 按类型分配与按大小分配共用大小类别
+        auto [ptr4, n]{::allocator_t::allocate<int>(16)};
+        CHECK_EQ(n, 16);
+        CHECK_EQ(::allocator_t::get_miss_cnt(), 4);
+        ::allocator_t::deallocate(ptr4, 16);
+        CHECK_EQ(static_cast<void*>(::allocator_t::allocate<::std::array<int, 16>>()), static_cast<void*>(ptr4));
+        CHECK_EQ(::allocator_t::get_hit_cnt(), 3);
+        ::allocator_t::deallocate(ptr4, 16);
+        ::reset();
+    }
+
+    /// @test 测试大小类别用尽后直接归还上游分配器
+    REGISTER_TEST_CASE("class exhausted" * ::doctest::description{"测试大小类别用尽后直接归还上游分配器"})
+    {
+        ::reset();
+        for(auto size: ::std::array{16zu, 24zu, 40zu}) { ::allocator_t::deallocate(::allocator_t::allocate(size), size); }
+        CHECK_EQ(::SoC::std_allocator::deallocate_cnt, 1);
+        auto ptr{::allocator_t::allocate(24)};
+        CHECK_EQ(::allocator_t::get_hit_cnt(), 1);
+        ::allocator_t::deallocate(ptr, 24);
+        CHECK_EQ(::allocator_t::get_miss_cnt(), 3);
+        ::reset();
+    }
+
+    /// @test 测试重复创建的协程复用协程帧
+    REGISTER_TEST_CASE("coroutine" * ::doctest::description{"测试重复创建的协程复用协程帧"})
+    {
+        ::reset();
+        ::SoC::scheduler<4, 4> scheduler{};
+        auto coro{[](::SoC::scheduler_base& scheduler [[maybe_unused]]) static -> ::SoC::task_base<::allocator_t>
+                  { co_return ::std::errc{}; }};
+
+        for(auto i{0zu}; i != 4; ++i)
+        {
+            scheduler.spawn(coro(scheduler));
+            scheduler.run();
+        }
+        CHECK_EQ(::allocator_t::get_miss_cnt(), 1);
+        CHECK_EQ(::allocator_t::get_hit_cnt(), 3);
+        CHECK_EQ(::SoC::std_allocator::allocate_cnt, 1);
+        ::allocator_t::release();
+        CHECK_EQ(::SoC::std_allocator::deallocate_cnt, 1);
+    }
+}
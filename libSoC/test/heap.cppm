@@ -16,23 +16,43 @@ export namespace SoC::test
      */
     extern "C++" struct heap : ::SoC::heap
     {
+        using ::SoC::heap::acquire_free_run;
         using ::SoC::heap::allocate_cold_path;
         using ::SoC::heap::allocate_pages;
+        using ::SoC::heap::bitmap_cnt;
+        using ::SoC::heap::bitmap_word_bits;
+        using ::SoC::heap::bitmap_word_t;
+        using ::SoC::heap::bitmap_words;
+        using ::SoC::heap::bitmaps;
         using ::SoC::heap::block_size_cnt;
         using ::SoC::heap::data;
         using ::SoC::heap::deallocate_pages;
+        using ::SoC::heap::deferred_list;
+        using ::SoC::heap::drain_deferred_list;
         using ::SoC::heap::free_list_t;
         using ::SoC::heap::free_page_list;
+        using ::SoC::heap::free_run_list;
+        using ::SoC::heap::free_run_list_t;
+        using ::SoC::heap::get_empty_page_bitmap;
+        using ::SoC::heap::get_free_page_bitmap;
         using ::SoC::heap::get_metadata_index;
+        using ::SoC::heap::get_page_begin;
+        using ::SoC::heap::get_page_index;
         using ::SoC::heap::heap;
         using ::SoC::heap::insert_block_into_page_list;
+        using ::SoC::heap::invalid_order;
         using ::SoC::heap::make_block_in_page;
+        using ::SoC::heap::max_order;
         using ::SoC::heap::metadata;
         using ::SoC::heap::min_block_shift;
         using ::SoC::heap::page_gc;
         using ::SoC::heap::page_shift;
+        using ::SoC::heap::pop_free_run;
         using ::SoC::heap::ptr_size;
-        using ::SoC::heap::remove_pages;
+        using ::SoC::heap::push_free_run;
+        using ::SoC::heap::release_pages;
+        using ::SoC::heap::set_bit;
+        using ::SoC::heap::test_bit;
     };
 }  // namespace SoC::test
 
@@ -99,4 +119,65 @@ export namespace SoC::unit_test::heap
 
     using metadata_t = ::std::remove_reference_t<decltype(::SoC::test::heap::metadata.front())>;
     using free_block_list_t = ::std::remove_pointer_t<decltype(::SoC::unit_test::heap::metadata_t::free_block_list)>;
+
+    /**
+     * @brief 统计伙伴系统中的空闲页数，并检查页块首页记录的阶数
+     *
+     * @param heap 堆对象
+     * @return 伙伴系统中的空闲页数
+     */
+    ::std::size_t get_free_run_pages(const ::SoC::test::heap& heap)
+    {
+        auto cnt{0zu};
+        for(auto&& [order, head]: ::std::views::zip(::std::views::iota(0zu), heap.free_run_list))
+        {
+            for(auto* page{head}; page != nullptr; page = page->next_page)
+            {
+                CAPTURE(order);
+                CHECK_EQ(page->order, order);
+                cnt += 1zu << order;
+            }
+        }
+        return cnt;
+    }
+
+    /**
+     * @brief 获取块所在页的元数据指针
+     *
+     * @param heap 堆对象
+     * @param block_ptr 块指针
+     * @return 页元数据指针
+     */
+    ::SoC::unit_test::heap::metadata_t* get_block_page(::SoC::test::heap& heap, void* block_ptr)
+    {
+        auto* page_ptr{static_cast<::SoC::unit_test::heap::free_block_list_t*>(block_ptr)};
+        return &heap.metadata[static_cast<::std::size_t>(heap.get_metadata_index(page_ptr))];
+    }
+
+    /**
+     * @brief 检查页是否在对应块大小的空页位图中
+     *
+     * @param heap 堆对象
+     * @param page 页元数据指针
+     * @return 页是否为空页
+     */
+    bool is_empty_page(::SoC::test::heap& heap, const ::SoC::unit_test::heap::metadata_t* page)
+    {
+        return ::SoC::test::heap::test_bit(heap.get_empty_page_bitmap(page->block_size_shift - heap.min_block_shift),
+                                           heap.get_page_index(page));
+    }
+
+    /**
+     * @brief 清空伙伴系统，模拟没有空闲页块的堆
+     *
+     * @param heap 堆对象
+     */
+    void clear_free_run_list(::SoC::test::heap& heap) noexcept
+    {
+        for(auto&& head: heap.free_run_list)
+        {
+            for(auto* page{head}; page != nullptr; page = page->next_page) { page->order = ::SoC::test::heap::invalid_order; }
+            head = nullptr;
+        }
+    }
 }  // namespace SoC::unit_test::heap
@@ -18,97 +18,143 @@ TEST_SUITE("heap_allocate" * ::doctest::description{"SoC::heap分配函数单元
     REGISTER_TEST_CASE("page_gc" * ::doctest::description{"测试堆的页回收函数能否正常工作"})
     {
         auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
-        // 将空闲页链表中的页插入index处的空闲块链表
-        auto insert_block_into_page_list{
-            [&heap](::std::size_t index, bool is_free = true) noexcept
-            {
-                auto&& free_page_list{heap.free_page_list.back()};
-                auto* old_free_page_head{::std::exchange(free_page_list, free_page_list->next_page)};
-                auto* old_free_block_head{::std::exchange(heap.free_page_list[index], old_free_page_head)};
-                old_free_page_head->next_page = old_free_block_head;
-                old_free_page_head->used_block = !is_free;
-                old_free_page_head->block_size_shift = index + heap.min_block_shift;
-                return old_free_page_head;
-            }};
+        // 分配count个size字节的块
+        auto allocate_blocks{[&heap](::std::size_t size, ::std::size_t count)
+                             {
+                                 ::std::vector<void*> blocks(count);
+                                 for(auto&& block: blocks) { block = heap.allocate(size); }
+                                 return blocks;
+                             }};
+        auto get_page{[&heap](void* block_ptr) { return ::SoC::unit_test::heap::get_block_page(heap, block_ptr); }};
 
         // 16字节块链表保持空
-        heap.free_page_list[0] = nullptr;
-        // 32字节块链表插入1个空闲块
-        auto* page_ptr32{insert_block_into_page_list(1)};
-        // 64字节块链表插入1个非空闲块
-        auto* page_ptr64{insert_block_into_page_list(2, false)};
-        // 128字节块链表插入1个空闲块1个非空闲块
-        auto* page_ptr128_1{insert_block_into_page_list(3)};
-        auto* page_ptr128_2{insert_block_into_page_list(3, false)};
-        // 256字节块链表交替插入2个空闲块和2个非空闲块
-        auto* page_ptr256_1{insert_block_into_page_list(4)};
-        auto* page_ptr256_2{insert_block_into_page_list(4, false)};
-        auto* page_ptr256_3{insert_block_into_page_list(4)};
-        auto* page_ptr256_4{insert_block_into_page_list(4, false)};
-        auto* origin_free_page_list_head{heap.free_page_list.back()};
+        // 32字节块链表中有1个空页
+        auto* block_ptr32{heap.allocate(32)};
+        auto* page_ptr32{get_page(block_ptr32)};
+        heap.deallocate(block_ptr32, 32);
+        // 64字节块链表中有1个非空页
+        auto* page_ptr64{get_page(heap.allocate(64))};
+        // 128字节块链表中有1个空页和1个非空页
+        constexpr auto block_per_page128{::SoC::heap::page_size / 128};
+        auto blocks128{allocate_blocks(128, block_per_page128 + 1)};
+        auto* page_ptr128_1{get_page(blocks128.front())};
+        auto* page_ptr128_2{get_page(blocks128.back())};
+        for(auto* block_ptr: ::std::span{blocks128}.first(block_per_page128)) { heap.deallocate(block_ptr, 128); }
+        // 256字节块链表中空页和非空页交替出现
+        auto blocks256{allocate_blocks(256, 7)};
+        auto* page_ptr256_1{get_page(blocks256[0])};
+        auto* page_ptr256_2{get_page(blocks256[2])};
+        auto* page_ptr256_3{get_page(blocks256[4])};
+        auto* page_ptr256_4{get_page(blocks256[6])};
+        for(auto index: {0zu, 1zu, 2zu, 4zu, 5zu}) { heap.deallocate(blocks256[index], 256); }
 
         SUBCASE("prepare")
         {
-            constexpr auto message{"块插入失败"sv};
-            REQUIRE_MESSAGE(page_ptr32->next_page == nullptr, message);
-            REQUIRE_MESSAGE(page_ptr32 == heap.free_page_list[1], message);
-
-            REQUIRE_MESSAGE(page_ptr64->next_page == nullptr, message);
-            REQUIRE_MESSAGE(page_ptr64 == heap.free_page_list[2], message);
-
-            REQUIRE_MESSAGE(page_ptr128_1->next_page == nullptr, message);
-            REQUIRE_MESSAGE(page_ptr128_2->next_page == page_ptr128_1, message);
-            REQUIRE_MESSAGE(page_ptr128_2 == heap.free_page_list[3], message);
-
-            REQUIRE_MESSAGE(page_ptr256_1->next_page == nullptr, message);
-            REQUIRE_MESSAGE(page_ptr256_2->next_page == page_ptr256_1, message);
-            REQUIRE_MESSAGE(page_ptr256_3->next_page == page_ptr256_2, message);
-            REQUIRE_MESSAGE(page_ptr256_4->next_page == page_ptr256_3, message);
-            REQUIRE_MESSAGE(page_ptr256_4 == heap.free_page_list[4], message);
+            constexpr auto message{"空页位图设置失败"sv};
+            for(auto* page_ptr: {page_ptr32, page_ptr128_1, page_ptr256_1, page_ptr256_3})
+            {
+                REQUIRE_EQ(page_ptr->used_block, 0);
+                REQUIRE_MESSAGE(::SoC::unit_test::heap::is_empty_page(heap, page_ptr), message);
+            }
+            for(auto* page_ptr: {page_ptr64, page_ptr128_2, page_ptr256_2, page_ptr256_4})
+            {
+                REQUIRE_EQ(page_ptr->used_block, 1);
+                REQUIRE_MESSAGE(!::SoC::unit_test::heap::is_empty_page(heap, page_ptr), message);
+            }
         }
 
         SUBCASE("with free block")
         {
-            ::SoC::unit_test::heap::metadata_t* current_free_page_list_head{};
-            REQUIRE_NOTHROW_MESSAGE(current_free_page_list_head = heap.page_gc(true), "堆含有空闲块，不应出现空间不足错误"sv);
-            // 检查空闲页链表的头指针是否正确
-            CHECK_EQ(current_free_page_list_head, page_ptr256_1);
+            auto free_run_pages{::SoC::unit_test::heap::get_free_run_pages(heap)};
+            auto free_pages{heap.get_free_pages()};
+            // 空闲的已分块页计入空闲页，但在回收前不属于伙伴系统
+            CHECK_EQ(heap.get_free_run_pages(), free_run_pages);
+            CHECK_EQ(free_pages, free_run_pages + 4);
+            // 检查回收的页数是否为空页的数量
+            CHECK_EQ(heap.page_gc(), 4);
             // 检查16字节块链表是否保持空
             CHECK_EQ(heap.free_page_list[0], nullptr);
-            // 检查32字节块链表是否为空，即空闲块被回收
+            // 检查32字节块链表是否为空，即空页被回收
             CHECK_EQ(heap.free_page_list[1], nullptr);
-            // 检查64字节块链表是否为原链表头，即非空闲块未被回收
+            // 检查64字节块链表是否为原链表头，即非空页未被回收
             CHECK_EQ(heap.free_page_list[2], page_ptr64);
             CHECK_EQ(heap.free_page_list[2]->next_page, nullptr);
-            // 检查128字节块链表是否为非空闲块，即空闲块被回收而非空闲块未被回收
+            // 检查128字节块链表是否为非空页，即空页被回收而非空页未被回收
             CHECK_EQ(heap.free_page_list[3], page_ptr128_2);
             CHECK_EQ(heap.free_page_list[3]->next_page, nullptr);
-            // 检查256字节块链表是否为非空闲块，即穿插在非空闲块内的空闲块是否被回收
-            CHECK_EQ(heap.free_page_list[4], page_ptr256_4);
-            CHECK_EQ(heap.free_page_list[4]->next_page, page_ptr256_2);
-            CHECK_EQ(heap.free_page_list[4]->next_page->next_page, nullptr);
-
-            ::std::array free_page_list_gt{page_ptr256_1, page_ptr256_3, page_ptr128_1, page_ptr32, origin_free_page_list_head};
-            for(auto* page_ptr{heap.free_page_list.back()};
-                auto&& [index_in_free_page_list_gt, page_ptr_gt]: ::std::views::zip(::std::views::iota(0), free_page_list_gt))
+            CHECK_EQ(heap.free_page_list[3]->prev_page, nullptr);
+            // 检查256字节块链表是否为非空页，即穿插在非空页内的空页是否被回收
+            CHECK_EQ(heap.free_page_list[4], page_ptr256_2);
+            CHECK_EQ(page_ptr256_2->prev_page, nullptr);
+            CHECK_EQ(page_ptr256_2->next_page, page_ptr256_4);
+            CHECK_EQ(page_ptr256_4->prev_page, page_ptr256_2);
+            CHECK_EQ(page_ptr256_4->next_page, nullptr);
+
+            // 检查回收的页是否归还伙伴系统
+            CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), free_run_pages + 4);
+            CHECK_EQ(heap.get_free_run_pages(), free_pages);
+            // 回收前后空闲页数不变
+            CHECK_EQ(heap.get_free_pages(), free_pages);
+            for(auto* page_ptr: {page_ptr32, page_ptr128_1, page_ptr256_1, page_ptr256_3})
             {
-                CAPTURE(index_in_free_page_list_gt);
-                CHECK_EQ(page_ptr, page_ptr_gt);
                 // 检查块大小是否正确设置为页大小
                 CHECK_EQ(page_ptr->block_size_shift, heap.page_shift);
-                page_ptr = page_ptr->next_page;
+                CHECK_EQ(page_ptr->free_block_list, heap.get_page_begin(page_ptr));
             }
+            // 检查空页位图是否已清空
+            for(auto free_list_index{0zu}; free_list_index != heap.free_page_list.size(); ++free_list_index)
+            {
+                CAPTURE(free_list_index);
+                CHECK(::std::ranges::all_of(heap.get_empty_page_bitmap(free_list_index),
+                                            [](auto word) static noexcept { return word == 0; }));
+            }
+            // 没有空页时不回收任何页
+            CHECK_EQ(heap.page_gc(), 0);
         }
+    }
 
-        SUBCASE("without free block")
+    /// @test 测试从伙伴系统中获取空闲页块
+    REGISTER_TEST_CASE("acquire_free_run" * ::doctest::description{"测试从伙伴系统中获取空闲页块"})
+    {
+        auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
+
+        SUBCASE("free run available")
         {
-            for(auto&& free_page_list{heap.free_page_list}; auto&& free_page: free_page_list) { free_page = nullptr; }
-            // 启用断言的情况下，应当断言失败
-            CHECK_THROWS_WITH_AS_MESSAGE(heap.page_gc(true),
+            ::fakeit::Mock mock{heap};
+            const auto method{Method(mock, page_gc)};
+            ::fakeit::Fake(method);
+            auto&& heap{mock.get()};
+
+            auto* page{heap.free_run_list[0]};
+            CHECK_EQ(heap.acquire_free_run(0), page);
+            // 伙伴系统中有足够的页，不应回收页
+            ::fakeit::Verify(method).Never();
+        }
+
+        SUBCASE("reclaim free block")
+        {
+            auto* block_ptr{heap.allocate(16)};
+            auto* page{::SoC::unit_test::heap::get_block_page(heap, block_ptr)};
+            heap.deallocate(block_ptr, 16);
+            ::SoC::unit_test::heap::clear_free_run_list(heap);
+
+            CHECK_EQ(heap.acquire_free_run(0), page);
+            // 检查空闲块是否被page_gc回收
+            CHECK_EQ(heap.free_page_list.front(), nullptr);
+            CHECK_EQ(page->block_size_shift, heap.page_shift);
+        }
+
+        SUBCASE("heap full")
+        {
+            ::SoC::unit_test::heap::clear_free_run_list(heap);
+            CHECK_THROWS_WITH_AS_MESSAGE(heap.acquire_free_run(0),
                                          ::doctest::Contains{"剩余堆空间不足"},
                                          ::SoC::assert_failed_exception,
-                                         "剩余堆空间不足，应该断言失败"sv);
-            CHECK_NOTHROW_MESSAGE(heap.page_gc(false), "禁用断言时，剩余堆空间不足不应该产生断言失败"sv);
+                                         "堆中不存在空闲块和空闲页，应该断言失败"sv);
+            CHECK_THROWS_WITH_AS_MESSAGE(heap.acquire_free_run(1),
+                                         ::doctest::Contains{"堆中剩余连续分页数量不足"},
+                                         ::SoC::assert_failed_exception,
+                                         "堆中不存在空闲块和空闲页，应该断言失败"sv);
         }
     }
 
@@ -118,34 +164,43 @@ TEST_SUITE("heap_allocate" * ::doctest::description{"SoC::heap分配函数单元
         SUBCASE("free_block_list not empty")
         {
             auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
-            // 模拟空闲页链表非空
-            heap.free_page_list.front() = heap.free_page_list.back();
+            // 模拟块空闲链表非空
+            heap.free_page_list.front() = heap.metadata.data();
             CHECK_THROWS_WITH_AS_MESSAGE(heap.make_block_in_page(0),
                                          ::doctest::Contains{"仅在块空闲链表为空时调用此函数"},
                                          ::SoC::assert_failed_exception,
                                          "空闲页链表非空，应该断言失败"sv);
         }
 
-        SUBCASE("free_page_list not empty")
+        SUBCASE("free run available")
         {
             auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
-            auto* current_page{heap.free_page_list.back()};
-            auto* next_page{current_page->next_page};
-            REQUIRE_MESSAGE(current_page != nullptr, "空闲页链表不应为空"sv);
+            // 1页的空闲页块为空，应当拆分最小的空闲页块
+            REQUIRE_EQ(heap.free_run_list[0], nullptr);
+            auto min_order{static_cast<::std::size_t>(::std::ranges::distance(
+                heap.free_run_list | ::std::views::take_while([](auto* page) static noexcept { return page == nullptr; })))};
+            REQUIRE_LE(min_order, heap.max_order);
+            auto* current_page{heap.free_run_list[min_order]};
             auto page_begin{::std::bit_cast<::std::uintptr_t>(current_page->free_block_list)};
             constexpr auto block_index{0zu};
             constexpr auto block_size{1zu << (::SoC::test::heap::min_block_shift + block_index)};
             ::SoC::unit_test::heap::free_block_list_t* free_block_ptr{};
-            REQUIRE_NOTHROW_MESSAGE(free_block_ptr = heap.make_block_in_page(block_index), "空闲页链表非空，应该能够成功分块"sv);
+            REQUIRE_NOTHROW_MESSAGE(free_block_ptr = heap.make_block_in_page(block_index), "伙伴系统非空，应该能够成功分块"sv);
 
             // 首个空闲块地址应当是页起始地址
             CHECK_EQ(free_block_ptr, ::std::bit_cast<void*>(page_begin));
-            // 空闲页链表头应该移到下一页
-            CHECK_EQ(heap.free_page_list.back(), next_page);
+            // 页块拆分后，其余部分按阶数归还伙伴系统
+            for(auto order{0zu}; order != min_order; ++order)
+            {
+                CAPTURE(order);
+                CHECK_EQ(heap.free_run_list[order], current_page + (1zu << order));
+            }
+            CHECK_NE(heap.free_run_list[min_order], current_page);
             // 空闲块链表头应该是当前页
             CHECK_EQ(heap.free_page_list[block_index], current_page);
             // 分块后的页是该块大小对应的空闲链表中唯一的一项，因此next_page为nullptr
             CHECK_EQ(current_page->next_page, nullptr);
+            CHECK_EQ(current_page->order, heap.invalid_order);
             // 检查块大小是否正确设置
             CHECK_EQ(current_page->block_size_shift, heap.min_block_shift + block_index);
             constexpr auto page_size{::SoC::heap::page_size};
@@ -162,31 +217,34 @@ TEST_SUITE("heap_allocate" * ::doctest::description{"SoC::heap分配函数单元
             }
         }
 
-        SUBCASE("free_page_list empty")
+        SUBCASE("free_run_list empty")
         {
             auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
-            auto* current_page{::std::exchange(heap.free_page_list.back(), nullptr)};
-            // 将堆设置为只有1页，因此next_page为nullptr
-            current_page->next_page = nullptr;
-            heap.free_page_list.front() = current_page;
+            // 将16字节块链表设置为只有1页
+            auto* block_ptr{heap.allocate(16)};
+            auto* current_page{::SoC::unit_test::heap::get_block_page(heap, block_ptr)};
+            ::SoC::unit_test::heap::clear_free_run_list(heap);
             constexpr auto block_index{1zu};
 
             SUBCASE("no free block")
             {
-                current_page->used_block = 1;
-                CHECK_THROWS_AS_MESSAGE(heap.make_block_in_page(block_index),
-                                        ::SoC::assert_failed_exception,
-                                        "无空闲块且空闲链表为空，page_gc应该断言失败"sv);
+                CHECK_THROWS_WITH_AS_MESSAGE(heap.make_block_in_page(block_index),
+                                             ::doctest::Contains{"剩余堆空间不足"},
+                                             ::SoC::assert_failed_exception,
+                                             "无空闲块且伙伴系统为空，应该断言失败"sv);
             }
 
             SUBCASE("with free block")
             {
-                current_page->used_block = 0;
-                REQUIRE_NOTHROW_MESSAGE(heap.make_block_in_page(block_index), "空闲页链表为空且有空闲块，应该能够成功分块"sv);
-                CHECK_EQ(heap.free_page_list.back(), nullptr);
+                heap.deallocate(block_ptr, 16);
+                REQUIRE_NOTHROW_MESSAGE(heap.make_block_in_page(block_index), "伙伴系统为空且有空闲块，应该能够成功分块"sv);
+                CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), 0);
+                CHECK_EQ(heap.free_page_list.front(), nullptr);
                 CHECK_EQ(heap.free_page_list[block_index], current_page);
                 CHECK_EQ(current_page->next_page, nullptr);
                 CHECK_EQ(current_page->block_size_shift, heap.min_block_shift + block_index);
+                // 分块后的页尚未使用，应标记为空页
+                CHECK(::SoC::unit_test::heap::is_empty_page(heap, current_page));
             }
         }
     }
@@ -195,198 +253,103 @@ TEST_SUITE("heap_allocate" * ::doctest::description{"SoC::heap分配函数单元
     REGISTER_TEST_CASE("allocate_pages" * ::doctest::description{"测试页分配函数"})
     {
         auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
+        auto total_pages{heap.get_total_pages()};
+
+        /**
+         * @brief 检查从首页开始的page_cnt页是否已分配
+         *
+         * @param first_page 首页元数据指针
+         * @param page_cnt 页数
+         */
+        auto check_allocated{[](::SoC::unit_test::heap::metadata_t* first_page, ::std::size_t page_cnt)
+                             {
+                                 for(auto&& page: ::std::span{first_page, page_cnt})
+                                 {
+                                     // 检查分配后页的used_block是否为1
+                                     CHECK_EQ(page.used_block, 1);
+                                     // 检查free_block_list是否为空
+                                     CHECK_EQ(page.free_block_list, nullptr);
+                                     // 检查分配后页的块大小是否为页大小
+                                     CHECK_EQ(page.block_size_shift, ::SoC::test::heap::page_shift);
+                                     CHECK_EQ(page.order, ::SoC::test::heap::invalid_order);
+                                 }
+                             }};
 
         SUBCASE("allocate a page")
         {
             void* page_ptr{};
+            auto* current_page{heap.pop_free_run(0)};
+            heap.push_free_run(current_page, 0);
+            REQUIRE_NOTHROW_MESSAGE(page_ptr = heap.allocate_pages(1), "堆中空闲页充足，分配不应该失败"sv);
+            // 检查分配的页是不是伙伴系统拆分出的首页
+            CHECK_EQ(page_ptr, heap.get_page_begin(current_page));
+            check_allocated(current_page, 1);
+            CHECK_EQ(heap.get_free_pages(), total_pages - 1);
+            CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), total_pages - 1);
+        }
 
-            SUBCASE("free_page_list not empty")
-            {
-                auto* current_page{heap.free_page_list.back()};
-                auto* next_page{current_page->next_page};
-                auto* block_ptr{current_page->free_block_list};
-                REQUIRE_NOTHROW_MESSAGE(page_ptr = heap.allocate_pages(1), "堆中空闲页充足，分配不应该失败"sv);
-                // 检查分配的页是不是空闲页表头部的页
-                CHECK_EQ(page_ptr, block_ptr);
-                // 检查free_block_list是否为空
-                CHECK_EQ(current_page->free_block_list, nullptr);
-                // 检查分配后的空闲页表头是不是指向下一页
-                CHECK_EQ(heap.free_page_list.back(), next_page);
-                // 检查分配后的空闲页表中该页的used_block是否为1
-                CHECK_EQ(current_page->used_block, 1);
-                CHECK_EQ(next_page->used_block, 0);
-                // 检查分配后的空闲页表中该页的块大小是否为页大小
-                CHECK_EQ(current_page->block_size_shift, heap.page_shift);
-            }
+        SUBCASE("allocate pages")
+        {
+            constexpr auto message{"堆中空闲页充足，分配不应该失败"sv};
+            ::fakeit::Mock mock{heap};
+            const auto method{Method(mock, page_gc)};
+            ::fakeit::Fake(method);
+            auto&& heap{mock.get()};
 
-            SUBCASE("free_page_list empty")
+            SUBCASE("power of 2")
             {
-                auto* current_page{::std::exchange(heap.free_page_list.back(), nullptr)};
-                current_page->next_page = nullptr;
-                heap.free_page_list.front() = current_page;
-                auto* block_ptr{current_page->free_block_list};
-
-                REQUIRE_NOTHROW_MESSAGE(page_ptr = heap.allocate_pages(1), "可以通过page_gc回收空闲块，分配不应该失败"sv);
-                // 检查分配的页是不是空闲页表头部的页
-                CHECK_EQ(page_ptr, block_ptr);
-                // 检查free_block_list是否为空
-                CHECK_EQ(current_page->free_block_list, nullptr);
-                // 检查分配后的空闲页表头是不是为空
-                CHECK_EQ(heap.free_page_list.back(), nullptr);
-                // 检查分配后的空闲页表中该页的used_block是否为1
-                CHECK_EQ(current_page->used_block, 1);
-                CHECK_EQ(current_page->next_page, nullptr);
-                // 检查分配后的空闲页表中该页的块大小是否为页大小
-                CHECK_EQ(current_page->block_size_shift, heap.page_shift);
-                // 检查空闲块是否被page_gc回收
-                CHECK_EQ(heap.free_page_list.front(), nullptr);
+                auto* first_page{heap.pop_free_run(2)};
+                heap.push_free_run(first_page, 2);
+                void* page_ptr{};
+                REQUIRE_NOTHROW_MESSAGE(page_ptr = heap.allocate_pages(4), message);
+                CHECK_EQ(page_ptr, heap.get_page_begin(first_page));
+                check_allocated(first_page, 4);
+                // 检查分配的页数恰好为4页
+                CHECK_EQ(first_page[4].used_block, 0);
+                CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), total_pages - 4);
             }
 
-            SUBCASE("heap empty")
+            SUBCASE("not power of 2")
             {
-                ::std::ranges::fill(heap.free_page_list, nullptr);
-
-                CHECK_THROWS_AS_MESSAGE(page_ptr = heap.allocate_pages(1),
-                                        ::SoC::assert_failed_exception,
-                                        "堆中不存在空闲块和空闲页，page_gc应该断言失败"sv);
+                auto* first_page{heap.pop_free_run(2)};
+                heap.push_free_run(first_page, 2);
+                void* page_ptr{};
+                REQUIRE_NOTHROW_MESSAGE(page_ptr = heap.allocate_pages(3), message);
+                CHECK_EQ(page_ptr, heap.get_page_begin(first_page));
+                check_allocated(first_page, 3);
+                // 多余的1页归还伙伴系统，且不能与已分配的页合并
+                auto* rest_page{first_page + 3};
+                CHECK_EQ(rest_page->used_block, 0);
+                CHECK_EQ(rest_page->order, 0);
+                CHECK_EQ(heap.free_run_list[0], rest_page);
+                CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), total_pages - 3);
             }
+
+            // 伙伴系统中有足够的页，不应回收页
+            ::fakeit::Verify(method).Never();
         }
 
-        SUBCASE("allocate pages")
+        SUBCASE("not enough free pages")
         {
-            SUBCASE("with enough free pages")
+            const ::doctest::Contains exception_string{"堆中剩余连续分页数量不足"};
+
+            SUBCASE("no enough continuous page")
             {
-                constexpr auto message{"堆中空闲页充足，分配不应该失败"sv};
-                ::fakeit::Mock mock{heap};
-                const auto method{Method(mock, page_gc)};
-                ::fakeit::Fake(method);
-                auto&& heap{mock.get()};
-
-                SUBCASE("continuous pages at head")
-                {
-                    auto* first_page{heap.free_page_list.back()};
-                    auto* block_ptr{first_page->free_block_list};
-                    auto* second_page{first_page->next_page};
-                    auto* third_page{second_page->next_page};
-
-                    void* page_ptr{};
-                    REQUIRE_NOTHROW_MESSAGE(page_ptr = heap.allocate_pages(2), message);
-                    // 验证是否进入了多页分配路径
-                    ::fakeit::Verify(method).Exactly(1);
-                    // 检查分配的页是不是空闲页表头部的页
-                    CHECK_EQ(page_ptr, block_ptr);
-                    // 检查分配后的空闲页表头是不是指向下一页
-                    CHECK_EQ(heap.free_page_list.back(), third_page);
-                    // 检查分配后的空闲页表中该页的used_block是否为1
-                    CHECK_EQ(first_page->used_block, 1);
-                    CHECK_EQ(second_page->used_block, 1);
-                    CHECK_EQ(third_page->used_block, 0);
-                    // 检查分配后的空闲页表中该页的块大小是否为页大小
-                    CHECK_EQ(first_page->block_size_shift, heap.page_shift);
-                    CHECK_EQ(second_page->block_size_shift, heap.page_shift);
-                    // 检查分配后的空闲页表中该页的free_block_list是否为空
-                    CHECK_EQ(first_page->free_block_list, nullptr);
-                    CHECK_EQ(second_page->free_block_list, nullptr);
-                    CHECK_NE(third_page->free_block_list, nullptr);
-                }
-
-                SUBCASE("discontinuous pages at head")
-                {
-                    auto* first_page{heap.free_page_list.back()};
-                    auto* second_page{first_page->next_page};
-                    auto* third_page{second_page->next_page};
-                    auto* fourth_page{third_page->next_page};
-                    auto* fifth_page{fourth_page->next_page};
-                    auto* sixth_page{fifth_page->next_page};
-                    auto* seventh_page{sixth_page->next_page};
-                    // 设置第三页不为空，即需要从第四页开始查找连续页
-                    third_page->used_block = 1;
-                    third_page->free_block_list = nullptr;
-                    second_page->next_page = fourth_page;
-
-                    auto* block_ptr{fourth_page->free_block_list};
-                    void* page_ptr{};
-                    REQUIRE_NOTHROW_MESSAGE(page_ptr = heap.allocate_pages(3), message);
-                    // 验证是否进入了多页分配路径
-                    ::fakeit::Verify(method).Exactly(1);
-                    // 检查分配的页是不是空闲页表头部的页
-                    CHECK_EQ(page_ptr, block_ptr);
-                    auto* free_page_list{heap.free_page_list.back()};
-                    // 检查分配后的空闲页表头是不是指向第一页，因为该页未被分配
-                    CHECK_EQ(free_page_list, first_page);
-                    free_page_list = free_page_list->next_page;
-                    // 检查后续空闲链表连接是否正确
-                    CHECK_EQ(free_page_list, second_page);
-                    free_page_list = free_page_list->next_page;
-                    CHECK_EQ(free_page_list, seventh_page);
-                    // 检查分配后的空闲页表中该页的used_block是否为1
-                    CHECK_EQ(first_page->used_block, 0);
-                    CHECK_EQ(second_page->used_block, 0);
-                    CHECK_EQ(third_page->used_block, 1);
-                    CHECK_EQ(fourth_page->used_block, 1);
-                    CHECK_EQ(fifth_page->used_block, 1);
-                    CHECK_EQ(sixth_page->used_block, 1);
-                    CHECK_EQ(seventh_page->used_block, 0);
-                    // 检查分配后的空闲页表中该页的free_block_list是否为空
-                    CHECK_NE(first_page->free_block_list, nullptr);
-                    CHECK_NE(second_page->free_block_list, nullptr);
-                    CHECK_EQ(third_page->free_block_list, nullptr);
-                    CHECK_EQ(fourth_page->free_block_list, nullptr);
-                    CHECK_EQ(fifth_page->free_block_list, nullptr);
-                    CHECK_EQ(sixth_page->free_block_list, nullptr);
-                    CHECK_NE(seventh_page->free_block_list, nullptr);
-                    // 检查分配后的空闲页表中该页的块大小是否为页大小
-                    CHECK_EQ(first_page->block_size_shift, heap.page_shift);
-                    CHECK_EQ(second_page->block_size_shift, heap.page_shift);
-                    CHECK_EQ(third_page->block_size_shift, heap.page_shift);
-                    CHECK_EQ(fourth_page->block_size_shift, heap.page_shift);
-                    CHECK_EQ(fifth_page->block_size_shift, heap.page_shift);
-                    CHECK_EQ(sixth_page->block_size_shift, heap.page_shift);
-                }
+                // 堆中空闲页充足，但没有足够大的页块
+                CHECK_THROWS_WITH_AS_MESSAGE(heap.allocate_pages(total_pages),
+                                             exception_string,
+                                             ::SoC::assert_failed_exception,
+                                             "堆内没有足够连续页，allocate_pages应该断言失败"sv);
+                CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), total_pages);
             }
 
-            SUBCASE("not enough free pages")
+            SUBCASE("no free pages")
             {
-                const ::doctest::Contains exception_string{"堆中剩余连续分页数量不足"};
-                constexpr auto no_enough_continuous_page_message{"堆内没有足够连续页，allocate_pages应该断言失败"sv};
-
-                SUBCASE("no enough continuous page")
-                {
-                    auto* first_page{heap.free_page_list.back()};
-                    auto* second_page{first_page->next_page};
-                    second_page->next_page = nullptr;
-                    ::std::ranges::for_each(
-                        heap.metadata | ::std::views::filter([=](auto&& metadata) noexcept
-                                                             { return &metadata != first_page && &metadata != second_page; }),
-                        [](auto&& metadata) static noexcept { metadata.used_block = 1; });
-
-                    CHECK_THROWS_WITH_AS_MESSAGE(heap.allocate_pages(3),
-                                                 exception_string,
-                                                 ::SoC::assert_failed_exception,
-                                                 no_enough_continuous_page_message);
-                }
-
-                SUBCASE("scan reached end of heap")
-                {
-                    // 除最后一页外，其他页都被占用，相当于连续页空间不足
-                    for(auto&& metadata: heap.metadata.first(heap.metadata.size() - 1)) { metadata.used_block = 1; }
-                    heap.free_page_list.back() = &heap.metadata.back();
-
-                    CHECK_THROWS_WITH_AS_MESSAGE(heap.allocate_pages(2),
-                                                 exception_string,
-                                                 ::SoC::assert_failed_exception,
-                                                 no_enough_continuous_page_message);
-                }
-
-                SUBCASE("no free pages")
-                {
-                    for(auto&& metadata: heap.metadata) { metadata.used_block = 1; }
-
-                    CHECK_THROWS_WITH_AS_MESSAGE(heap.allocate_pages(2),
-                                                 exception_string,
-                                                 ::SoC::assert_failed_exception,
-                                                 "堆内没有空闲页，allocate_pages应该断言失败"sv);
-                }
+                ::SoC::unit_test::heap::clear_free_run_list(heap);
+                CHECK_THROWS_WITH_AS_MESSAGE(heap.allocate_pages(2),
+                                             exception_string,
+                                             ::SoC::assert_failed_exception,
+                                             "堆内没有空闲页，allocate_pages应该断言失败"sv);
             }
         }
     }
@@ -399,7 +362,9 @@ TEST_SUITE("heap_allocate" * ::doctest::description{"SoC::heap分配函数单元
         {
             auto do_check{[&heap](::std::size_t actual_size, ::std::size_t target_free_block_list_index)
                           {
-                              auto&& metadata{*heap.free_page_list.back()};
+                              auto* page{heap.pop_free_run(0)};
+                              heap.push_free_run(page, 0);
+                              auto&& metadata{*page};
                               auto* page_begin{metadata.free_block_list};
                               auto* next_block{::std::bit_cast<::SoC::unit_test::heap::free_block_list_t*>(
                                   ::std::bit_cast<::std::uintptr_t>(page_begin) + actual_size)};
@@ -465,8 +430,7 @@ TEST_SUITE("heap_allocate" * ::doctest::description{"SoC::heap分配函数单元
 
             SUBCASE("allocate page")
             {
-                // 由于会使用空闲页链表中缓存的页作为快速路径，因此先清空空闲页链表
-                heap.free_page_list.back() = nullptr;
+                // 整页分配由伙伴系统管理，总是进入冷路径
                 CHECK_EQ(heap.allocate(heap.page_size), nullptr);
                 ::fakeit::Verify(method).Once();
             }
@@ -483,8 +447,7 @@ TEST_SUITE("heap_allocate" * ::doctest::description{"SoC::heap分配函数单元
             // 分配一个块以初始化free_page_list
             for(auto i{heap.min_block_shift}; i < heap.page_shift; ++i) { auto* _{heap.allocate(1zu << i)}; }
 
-            for(::std::span span{heap.free_page_list};
-                auto&& [index, metadata]: ::std::views::zip(::std::views::iota(0zu), span.subspan(0, span.size() - 1)))
+            for(auto&& [index, metadata]: ::std::views::zip(::std::views::iota(0zu), heap.free_page_list))
             {
                 CAPTURE(index);
                 REQUIRE_NE(metadata, nullptr);
@@ -515,18 +478,16 @@ TEST_SUITE("heap_allocate" * ::doctest::description{"SoC::heap分配函数单元
             SUBCASE("allocate 256 bytes") { do_check(256, 4, true); }
             SUBCASE("allocate 512 bytes")
             {
-                auto* old_free_list{heap.free_page_list.back()};
-                auto* block_ptr{old_free_list->free_block_list};
-                auto* next_page{old_free_list->next_page};
+                auto* page{heap.pop_free_run(0)};
+                heap.push_free_run(page, 0);
+                auto* block_ptr{page->free_block_list};
                 auto* result{heap.allocate(512)};
-                // 检查分配的块是不是空闲块链表头部的块
+                // 检查分配的块是不是伙伴系统中1页空闲页块的首页
                 CHECK_EQ(result, block_ptr);
                 // 检查free_block_list是否为空
-                CHECK_EQ(old_free_list->free_block_list, nullptr);
+                CHECK_EQ(page->free_block_list, nullptr);
                 // 检查used_block是否为1
-                CHECK_EQ(old_free_list->used_block, 1);
-                // 检查分配后的空闲块表头是不是指向下一页
-                CHECK_EQ(heap.free_page_list.back(), next_page);
+                CHECK_EQ(page->used_block, 1);
             }
         }
 
@@ -567,4 +528,81 @@ TEST_SUITE("heap_allocate" * ::doctest::description{"SoC::heap分配函数单元
             CHECK_EQ(second_page->used_block, 2);
         }
     }
+
+    /// @test 测试按对齐要求分配内存
+    REGISTER_TEST_CASE("aligned allocate" * ::doctest::description{"测试按对齐要求分配内存"})
+    {
+        auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
+        auto total_pages{heap.get_total_pages()};
+
+        SUBCASE("aligned size")
+        {
+            // 不超过页大小时提升到对齐值，超过页大小时保持不变
+            CHECK_EQ(heap.get_aligned_allocate_size(24, 32), 32);
+            CHECK_EQ(heap.get_aligned_allocate_size(100, 32), 100);
+            CHECK_EQ(heap.get_aligned_allocate_size(8, heap.page_size), heap.page_size);
+            CHECK_EQ(heap.get_aligned_allocate_size(heap.page_size + 8, 64), heap.page_size + 8);
+        }
+
+        SUBCASE("invalid alignment")
+        {
+            CHECK_THROWS_WITH_AS_MESSAGE(heap.allocate(16, 24),
+                                         ::doctest::Contains{"对齐要求必须是不超过页大小的2的幂"},
+                                         ::SoC::assert_failed_exception,
+                                         "对齐要求不是2的幂，应该断言失败"sv);
+            CHECK_THROWS_WITH_AS_MESSAGE(heap.allocate(16, heap.page_size * 2),
+                                         ::doctest::Contains{"对齐要求必须是不超过页大小的2的幂"},
+                                         ::SoC::assert_failed_exception,
+                                         "对齐要求超过页大小，应该断言失败"sv);
+        }
+
+        SUBCASE("allocate")
+        {
+            // 先分配一个16字节块，使后续分配的块不位于页首
+            auto* block16{heap.allocate(16)};
+            for(auto alignment: {16zu, 32zu, 64zu})
+            {
+                auto* ptr{heap.allocate(24, alignment)};
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                CHECK_EQ(reinterpret_cast<::std::uintptr_t>(ptr) % alignment, 0);
+                CHECK_EQ(heap.get_allocated_size(ptr), ::std::max(32zu, alignment));
+                heap.deallocate(ptr, 24, alignment);
+            }
+            heap.deallocate(block16, 16);
+            heap.page_gc();
+            CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), total_pages);
+        }
+    }
+
+    /// @test 测试批量分配函数
+    REGISTER_TEST_CASE("allocate_batch" * ::doctest::description{"测试批量分配函数"})
+    {
+        auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
+        auto total_pages{heap.get_total_pages()};
+        // 每页32个16字节块，40个块需要跨越两页
+        ::std::array<void*, 40> blocks{};
+        REQUIRE_EQ(heap.allocate_batch(16, blocks), blocks.size());
+
+        auto&& page_metadata{*heap.free_page_list.front()};
+        // 第一页已分配满，从空闲链表中移除，第二页分配了剩余的8个块
+        CHECK_EQ(page_metadata.used_block, 8);
+        CHECK_EQ(page_metadata.prev_page, nullptr);
+        CHECK_EQ(heap.get_free_pages(), total_pages - 2);
+        CHECK_EQ(::std::ranges::adjacent_find(blocks), blocks.end());
+        for(auto* block: blocks)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            CHECK_EQ(reinterpret_cast<::std::uintptr_t>(block) % 16, 0);
+        }
+
+        // 整页分配逐个进行
+        ::std::array<void*, 2> pages{};
+        REQUIRE_EQ(heap.allocate_batch(heap.page_size, pages), pages.size());
+        CHECK_EQ(heap.get_free_pages(), total_pages - 4);
+
+        for(auto* block: blocks) { heap.deallocate(block, 16); }
+        for(auto* page: pages) { heap.deallocate(page, heap.page_size); }
+        heap.page_gc();
+        CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), total_pages);
+    }
 }
@@ -17,11 +17,10 @@ TEST_SUITE("heap_deallocate" * ::doctest::description{"SoC::heap释放函数单
     REGISTER_TEST_CASE("deallocate_pages" * ::doctest::description{"测试页释放函数"})
     {
         auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
-        auto&& free_page_list{heap.free_page_list.back()};
 
         SUBCASE("invalid page ptr")
         {
-            auto* first_page{free_page_list};
+            auto* first_page{heap.pop_free_run(0)};
             auto* page_ptr{first_page->free_block_list};
 
             SUBCASE("unaligned page ptr")
@@ -55,54 +54,43 @@ TEST_SUITE("heap_deallocate" * ::doctest::description{"SoC::heap释放函数单
 
         SUBCASE("deallocate pages")
         {
-            auto* first_page{::std::exchange(free_page_list, free_page_list->next_page)};
-            first_page->used_block = 1;
-            void* first_page_ptr{::std::exchange(first_page->free_block_list, nullptr)};
+            // 记录分配前的伙伴系统空闲链表，释放后所有页块应当合并回原状
+            auto free_run_list_gt{heap.free_run_list};
+            auto total_pages{heap.get_total_pages()};
 
-            SUBCASE("deallocate 1 page")
-            {
-                auto* second_page{::std::exchange(first_page->next_page, nullptr)};
-                CHECK_NOTHROW_MESSAGE(heap.deallocate_pages(first_page_ptr, heap.page_size), "释放已分配的1页，不应当断言失败"sv);
-
-                // 检查页指针是否正确插入free_page_list中
-                CHECK_EQ(free_page_list, first_page);
-                // 检查second_page是否正确串在first_page后面形成链表
-                CHECK_EQ(first_page->next_page, second_page);
-                // 检查释放后first_page使用计数是否为0
-                CHECK_EQ(first_page->used_block, 0);
-                // 检查free_block_list是否正确恢复
-                CHECK_EQ(first_page->free_block_list, first_page_ptr);
-                // 检查second_page是否未被错误修改
-                CHECK_EQ(second_page->used_block, 0);
-            }
+            auto do_check{
+                [&](::std::size_t page_cnt)
+                {
+                    CAPTURE(page_cnt);
+                    void* page_ptr{};
+                    REQUIRE_NOTHROW_MESSAGE(page_ptr = heap.allocate_pages(page_cnt), "堆中空闲页充足，分配不应该失败"sv);
+                    auto* block_ptr{static_cast<::SoC::unit_test::heap::free_block_list_t*>(page_ptr)};
+                    auto metadata_index{static_cast<::std::size_t>(heap.get_metadata_index(block_ptr))};
+                    auto pages{heap.metadata.subspan(metadata_index, page_cnt)};
+                    REQUIRE_EQ(heap.get_free_pages(), total_pages - page_cnt);
 
-            SUBCASE("deallocate 2 pages")
-            {
-                first_page->next_page = nullptr;
-                auto* second_page{::std::exchange(free_page_list, free_page_list->next_page)};
-                second_page->used_block = 1;
-                auto* second_page_ptr{::std::exchange(second_page->free_block_list, nullptr)};
-                auto* third_page{::std::exchange(second_page->next_page, nullptr)};
-                CHECK_NOTHROW_MESSAGE(heap.deallocate_pages(first_page_ptr, heap.page_size * 2),
-                                      "释放已分配的2页，不应当断言失败"sv);
-
-                // 由于按页地址顺序释放，而free_page_list是FILO，所以second_page在first_page前
-                CHECK_EQ(free_page_list, second_page);
-                // 检查first_page是否正确串在second_page后面形成链表
-                CHECK_EQ(second_page->next_page, first_page);
-                // 检查释放后second_page使用计数是否为0
-                CHECK_EQ(second_page->used_block, 0);
-                // 检查second_page的free_block_list是否正确恢复
-                CHECK_EQ(second_page->free_block_list, second_page_ptr);
-                // 检查third_page是否正确串在first_page后面形成链表
-                CHECK_EQ(first_page->next_page, third_page);
-                // 检查释放后first_page使用计数是否为0
-                CHECK_EQ(first_page->used_block, 0);
-                // 检查first_page的free_block_list是否正确恢复
-                CHECK_EQ(first_page->free_block_list, first_page_ptr);
-                // 检查third_page是否未被错误修改
-                CHECK_EQ(third_page->used_block, 0);
-            }
+                    CHECK_NOTHROW_MESSAGE(heap.deallocate_pages(page_ptr, heap.page_size * page_cnt),
+                                          "释放已分配的页，不应当断言失败"sv);
+                    for(auto&& page: pages)
+                    {
+                        // 检查释放后使用计数是否为0
+                        CHECK_EQ(page.used_block, 0);
+                        // 检查free_block_list是否正确恢复
+                        CHECK_EQ(page.free_block_list, heap.get_page_begin(&page));
+                        CHECK_EQ(page.free_block_list->next, nullptr);
+                    }
+                    // 检查释放的页是否与伙伴合并，恢复分配前的状态
+                    CHECK_EQ(heap.free_run_list, free_run_list_gt);
+                    CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), total_pages);
+                }};
+
+            SUBCASE("deallocate 1 page") { do_check(1); }
+
+            SUBCASE("deallocate 2 pages") { do_check(2); }
+
+            SUBCASE("deallocate 3 pages") { do_check(3); }
+
+            SUBCASE("deallocate 5 pages") { do_check(5); }
         }
     }
 
@@ -121,10 +109,11 @@ TEST_SUITE("heap_deallocate" * ::doctest::description{"SoC::heap释放函数单
             auto&& heap{mock.get()};
             constexpr auto message{"deallocate_pages已mock为空实现，deallocate不应断言失败"sv};
 
+            CHECK_NOTHROW_MESSAGE(heap.deallocate(nullptr, heap.page_size), message);
             CHECK_NOTHROW_MESSAGE(heap.deallocate(nullptr, heap.page_size + 1), message);
             CHECK_NOTHROW_MESSAGE(heap.deallocate(nullptr, heap.page_size * 2), message);
 
-            ::fakeit::Verify(method).Exactly(2);
+            ::fakeit::Verify(method).Exactly(3);
         }
 
         SUBCASE("invalid block ptr")
@@ -206,6 +195,9 @@ TEST_SUITE("heap_deallocate" * ::doctest::description{"SoC::heap释放函数单
                     CHECK_EQ(metadata->free_block_list->next, next_block);
                     // 检查释放后使用计数是否为0
                     CHECK_EQ(metadata->used_block, 0);
+                    // 检查页是否标记为空页
+                    CHECK(heap.test_bit(heap.get_free_page_bitmap(), heap.get_page_index(metadata)));
+                    CHECK(::SoC::unit_test::heap::is_empty_page(heap, metadata));
                 }
             }
 
@@ -236,4 +228,173 @@ TEST_SUITE("heap_deallocate" * ::doctest::description{"SoC::heap释放函数单
             }
         }
     }
+
+    /// @test 测试延迟释放函数
+    REGISTER_TEST_CASE("deferred_deallocate" * ::doctest::description{"测试延迟释放函数"})
+    {
+        auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
+        auto total_pages{heap.get_total_pages()};
+        constexpr auto allocate_message{"分配内存，allocate函数不应当断言失败"sv};
+
+        void* block_ptr{};
+        void* pages_ptr{};
+        REQUIRE_NOTHROW_MESSAGE(block_ptr = heap.allocate(16), allocate_message);
+        REQUIRE_NOTHROW_MESSAGE(pages_ptr = heap.allocate(heap.page_size * 2), allocate_message);
+        auto&& metadata{*heap.free_page_list.front()};
+
+        /// 分配时批量释放延迟释放链表中的块
+        SUBCASE("drain on allocate")
+        {
+            heap.deferred_deallocate(block_ptr, 16);
+            heap.deferred_deallocate(pages_ptr, heap.page_size * 2);
+            // 延迟释放不修改堆结构
+            CHECK_NE(heap.deferred_list.load(), nullptr);
+            CHECK_EQ(metadata.used_block, 1);
+            CHECK_EQ(heap.get_free_pages(), total_pages - 3);
+
+            void* ptr{};
+            REQUIRE_NOTHROW_MESSAGE(ptr = heap.allocate(16), allocate_message);
+            CHECK_EQ(heap.deferred_list.load(), nullptr);
+            // 释放的块位于空闲块链表头部，因此被再次分配
+            CHECK_EQ(ptr, block_ptr);
+            CHECK_EQ(metadata.used_block, 1);
+            CHECK_EQ(heap.get_free_pages(), total_pages - 1);
+        }
+
+        /// page_gc时批量释放延迟释放链表中的块
+        SUBCASE("drain on page_gc")
+        {
+            heap.deferred_deallocate(block_ptr, 16);
+            heap.deferred_deallocate(pages_ptr, heap.page_size * 2);
+            CHECK_EQ(heap.page_gc(), 1);
+            CHECK_EQ(heap.deferred_list.load(), nullptr);
+            CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), total_pages);
+        }
+
+        /// 多个线程同时延迟释放
+        SUBCASE("concurrent")
+        {
+            heap.deallocate(block_ptr, 16);
+            heap.deallocate(pages_ptr, heap.page_size * 2);
+            constexpr auto thread_cnt{4zu};
+            constexpr auto block_cnt{256zu};
+            ::std::array<::std::vector<void*>, thread_cnt> blocks{};
+            for(auto&& thread_blocks: blocks)
+            {
+                for(auto i{0zu}; i != block_cnt; ++i) { thread_blocks.push_back(heap.allocate(32)); }
+            }
+            {
+                ::std::vector<::std::jthread> threads{};
+                for(auto&& thread_blocks: blocks)
+                {
+                    threads.emplace_back(
+                        [&heap, &thread_blocks]
+                        {
+                            for(auto* ptr: thread_blocks) { heap.deferred_deallocate(ptr, 32); }
+                        });
+                }
+            }
+            heap.drain_deferred_list();
+            CHECK_EQ(heap.get_free_pages(), total_pages);
+            heap.page_gc();
+            CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), total_pages);
+        }
+    }
+
+    /// @test 测试分配器是否支持不带大小的释放，协程帧在不支持sized deallocation时依赖该能力
+    REGISTER_TEST_CASE("unsized deallocate allocator" *
+                       ::doctest::description{"测试分配器是否支持不带大小的释放，协程帧在不支持sized deallocation时依赖该能力"})
+    {
+        CHECK(::SoC::is_unsized_deallocate_allocator<::SoC::ram_heap_allocator_t>);
+        CHECK(::SoC::is_unsized_deallocate_allocator<::SoC::ccmram_heap_allocator_t>);
+        CHECK(::SoC::is_unsized_deallocate_allocator<::SoC::interrupt_safe_ram_heap_allocator_t>);
+        // 模板形式的deallocate(type*, std::size_t = 1)虽然可以接受void*，但无法得到块大小
+        CHECK_FALSE(::SoC::is_unsized_deallocate_allocator<::SoC::std_allocator>);
+        CHECK_FALSE(::SoC::is_unsized_deallocate_allocator<::SoC::object_pool<::std::uint64_t, 4>>);
+        CHECK_FALSE(::SoC::is_unsized_deallocate_allocator<::SoC::frame_cache_allocator<::SoC::ram_heap_allocator_t>>);
+    }
+
+    /// @test 测试不带大小的释放函数
+    REGISTER_TEST_CASE("unsized deallocate" * ::doctest::description{"测试不带大小的释放函数"})
+    {
+        auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
+        auto total_pages{heap.get_total_pages()};
+        constexpr auto allocate_message{"分配内存，allocate函数不应当断言失败"sv};
+
+        void* block_ptr{};
+        void* pages_ptr{};
+        REQUIRE_NOTHROW_MESSAGE(block_ptr = heap.allocate(100), allocate_message);
+        REQUIRE_NOTHROW_MESSAGE(pages_ptr = heap.allocate((heap.page_size * 3) - 8), allocate_message);
+        CHECK_EQ(heap.get_allocated_size(block_ptr), 128);
+        // 3页的分配从4页的页块中取出，大小为实际页数而非页块大小
+        CHECK_EQ(heap.get_allocated_size(pages_ptr), heap.page_size * 3);
+
+        SUBCASE("not first page")
+        {
+            auto* second_page{static_cast<char*>(pages_ptr) + heap.page_size};
+            CHECK_THROWS_WITH_AS_MESSAGE(heap.deallocate(static_cast<void*>(second_page)),
+                                         ::doctest::Contains{"指针不是整页分配的首页"},
+                                         ::SoC::assert_failed_exception,
+                                         "指针不是整页分配的首页，应该断言失败"sv);
+            heap.deallocate(pages_ptr);
+            heap.deallocate(block_ptr);
+        }
+
+        SUBCASE("deallocate")
+        {
+            CHECK_NOTHROW(heap.deallocate(pages_ptr));
+            CHECK_EQ(heap.get_free_pages(), total_pages - 1);
+            CHECK_NOTHROW(heap.deallocate(block_ptr));
+            CHECK_EQ(heap.get_free_pages(), total_pages);
+            heap.page_gc();
+            CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), total_pages);
+        }
+    }
+
+    /// @test 测试批量释放函数
+    REGISTER_TEST_CASE("deallocate_batch" * ::doctest::description{"测试批量释放函数"})
+    {
+        auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
+        auto total_pages{heap.get_total_pages()};
+        ::std::array<void*, 40> blocks{};
+        REQUIRE_EQ(heap.allocate_batch(32, blocks), blocks.size());
+        auto&& free_list{heap.free_page_list[1]};
+        auto* last_page{free_list};
+
+        SUBCASE("partial")
+        {
+            // 释放第一页的前4个块，第一页原先已满，因此被插入空闲链表头部
+            heap.deallocate_batch(::std::span{blocks}.first(4), 32);
+            REQUIRE_NE(free_list, last_page);
+            CHECK_EQ(free_list->used_block, 12);
+            CHECK_EQ(free_list->next_page, last_page);
+            // 子链按输入顺序排列，尾部接上原空闲块链表
+            auto* block_list{free_list->free_block_list};
+            for(auto* block: ::std::span{blocks}.first(4))
+            {
+                CHECK_EQ(static_cast<void*>(block_list), block);
+                block_list = block_list->next;
+            }
+            CHECK_EQ(block_list, nullptr);
+            heap.deallocate_batch(::std::span{blocks}.subspan(4), 32);
+        }
+
+        SUBCASE("all")
+        {
+            heap.deallocate_batch(blocks, 32);
+            CHECK_EQ(heap.get_free_pages(), total_pages);
+        }
+
+        SUBCASE("size mismatch")
+        {
+            CHECK_THROWS_WITH_AS_MESSAGE(heap.deallocate_batch(::std::span{blocks}.first(2), 16),
+                                         ::doctest::Contains{"释放块大小与申请块大小不匹配"},
+                                         ::SoC::assert_failed_exception,
+                                         "释放块大小与申请块大小不匹配，应该断言失败"sv);
+            heap.deallocate_batch(blocks, 32);
+        }
+
+        heap.page_gc();
+        CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), total_pages);
+    }
 }
@@ -0,0 +1,212 @@
+/**
+ * @file heap_interrupt_safe.cpp
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief SoC::interrupt_safe_heap单元测试
+ */
+
+import "test_framework.hpp";
+import SoC.unit_test.heap;
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define REGISTER_TEST_CASE(NAME) TEST_CASE("heap_interrupt_safe/" NAME)
+
+namespace
+{
+    /**
+     * @brief 判断堆类型heap_t能否绑定到分配器allocator_t
+     *
+     * @tparam allocator_t 分配器类型
+     * @tparam heap_t 堆类型
+     */
+    template <typename allocator_t, typename heap_t>
+    concept can_bind_heap = requires(heap_t& heap) { allocator_t::set_heap(heap); };
+
+    /**
+     * @brief 将输出内容保存到字节数组的二进制设备
+     *
+     */
+    struct byte_device
+    {
+        ::std::vector<::std::byte> content{};
+
+        void write(const ::std::byte* begin, const ::std::byte* end) noexcept { content.insert(content.end(), begin, end); }
+    };
+
+    /**
+     * @brief 判断在当前线程持有临界区期间，其他线程中的operation是否等待临界区退出后才完成
+     *
+     * @param operation 要执行的操作
+     * @return operation是否被临界区阻塞
+     */
+    bool waits_for_critical_section(auto&& operation)
+    {
+        ::std::atomic_bool done{};
+        ::std::optional<::SoC::critical_section_guard> guard{::std::in_place};
+        ::std::jthread thread{[&operation, &done]
+                              {
+                                  operation();
+                                  done.store(true);
+                              }};
+        ::std::this_thread::sleep_for(::std::chrono::milliseconds{10});
+        auto blocked{!done.load()};
+        guard.reset();
+        thread.join();
+        return blocked && done.load();
+    }
+}  // namespace
+
+/// @test SoC::interrupt_safe_heap单元测试
+TEST_SUITE("heap_interrupt_safe" * ::doctest::description{"SoC::interrupt_safe_heap单元测试"})
+{
+    /// @test 测试临界区可以嵌套进入
+    REGISTER_TEST_CASE("nested critical section" * ::doctest::description{"测试临界区可以嵌套进入"})
+    {
+        ::std::optional<::SoC::critical_section_guard> outer{::std::in_place};
+        {
+            ::SoC::critical_section_guard inner{};
+        }
+        // 退出内层临界区后仍在外层临界区中，其他线程无法进入
+        ::std::atomic_bool entered{};
+        ::std::jthread thread{[&entered]
+                              {
+                                  ::SoC::critical_section_guard guard{};
+                                  entered.store(true);
+                              }};
+        ::std::this_thread::sleep_for(::std::chrono::milliseconds{10});
+        CHECK_FALSE(entered.load());
+        outer.reset();
+        thread.join();
+        CHECK(entered.load());
+    }
+
+    /// @test 测试多线程并发分配和释放
+    REGISTER_TEST_CASE("concurrent" * ::doctest::description{"测试多线程并发分配和释放"})
+    {
+        auto [begin, end]{::SoC::unit_test::heap::test_fixture::get_memory()};
+        ::SoC::interrupt_safe_heap heap{begin, end};
+        auto total_pages{heap.get_free_pages()};
+
+        constexpr auto thread_cnt{4zu};
+        constexpr auto round_cnt{4096zu};
+        ::std::atomic_size_t error_cnt{};
+        auto worker{[&heap, &error_cnt](::std::size_t seed)
+                    {
+                        ::std::mt19937 engine{static_cast<::std::uint32_t>(seed)};
+                        ::std::uniform_int_distribution<::std::size_t> size_dist{1, 2 * ::SoC::heap::page_size};
+                        ::std::vector<::std::pair<::std::byte*, ::std::size_t>> blocks{};
+                        for(auto i{0zu}; i != round_cnt; ++i)
+                        {
+                            if(blocks.size() < 8 && (blocks.empty() || engine() % 2 == 0))
+                            {
+                                auto size{size_dist(engine)};
+                                auto ptr{static_cast<::std::byte*>(heap.allocate(size))};
+                                ::std::ranges::fill_n(ptr, size, static_cast<::std::byte>(seed));
+                                blocks.emplace_back(ptr, size);
+                            }
+                            else
+                            {
+                                auto index{engine() % blocks.size()};
+                                auto [ptr, size]{blocks[index]};
+                                // 块内容未被其他线程改写
+                                auto pattern{static_cast<::std::byte>(seed)};
+                                if(::std::ranges::count(ptr, ptr + size, pattern) != static_cast<::std::ptrdiff_t>(size))
+                                {
+                                    error_cnt.fetch_add(1);
+                                }
+                                heap.deallocate(ptr, size);
+                                blocks[index] = blocks.back();
+                                blocks.pop_back();
+                            }
+                        }
+                        for(auto [ptr, size]: blocks) { heap.deallocate(ptr, size); }
+                    }};
+
+        {
+            ::std::vector<::std::jthread> threads{};
+            for(auto i{0zu}; i != thread_cnt; ++i) { threads.emplace_back(worker, i + 1); }
+        }
+        CHECK_EQ(error_cnt.load(), 0);
+        // 所有块释放后空闲页数恢复
+        CHECK_EQ(heap.get_free_pages(), total_pages);
+    }
+
+    /// @test 测试诊断接口在临界区中访问元数据和跟踪环
+    REGISTER_TEST_CASE("diagnostics" * ::doctest::description{"测试诊断接口在临界区中访问元数据和跟踪环"})
+    {
+        REQUIRE(::SoC::use_heap_trace);
+        auto [begin, end]{::SoC::unit_test::heap::test_fixture::get_memory()};
+        ::SoC::interrupt_safe_heap heap{begin, end};
+        auto* ptr{heap.allocate(10)};
+        ::std::array<::SoC::heap_trace_event, 4> buffer{};
+
+        auto largest_free_run{0zu};
+        CHECK(::waits_for_critical_section([&heap, &largest_free_run] { largest_free_run = heap.get_largest_free_run(); }));
+        CHECK_EQ(largest_free_run, heap.get_largest_free_run());
+        auto allocated_size{0zu};
+        CHECK(::waits_for_critical_section([&heap, &allocated_size, ptr] { allocated_size = heap.get_allocated_size(ptr); }));
+        CHECK_EQ(allocated_size, 16);
+
+        CHECK(::waits_for_critical_section([&heap, &buffer] { heap.set_trace_buffer(buffer); }));
+        heap.deallocate(ptr, 10);
+        ::byte_device device{};
+        CHECK(::waits_for_critical_section(
+            [&heap, &device]
+            {
+                ::SoC::bin_ofile<::byte_device, ::SoC::static_buffer<::std::byte, 16>> file{device};
+                heap.dump_trace<true>(file);
+            }));
+        // 转储头部之后恰好是一个释放事件
+        CHECK_EQ(device.content.size(), sizeof(::SoC::heap_trace_header) + sizeof(::SoC::heap_trace_event));
+        heap.set_trace_buffer({});
+    }
+
+    /// @test 测试可在中断中使用的堆只能通过对应的分配器访问
+    REGISTER_TEST_CASE("allocator" * ::doctest::description{"测试可在中断中使用的堆只能通过对应的分配器访问"})
+    {
+        // 目标平台上主内存分配器只调用基类的allocate/deallocate，绑定可在中断中使用的堆会绕过临界区
+        // 单元测试中allocate/deallocate为虚函数，运行时行为与目标平台不同，因此只能在编译期检查
+        CHECK_FALSE(::can_bind_heap<::SoC::ram_heap_allocator_t, ::SoC::interrupt_safe_heap>);
+        CHECK(::can_bind_heap<::SoC::ram_heap_allocator_t, ::SoC::heap>);
+        CHECK(::can_bind_heap<::SoC::interrupt_safe_ram_heap_allocator_t, ::SoC::interrupt_safe_heap>);
+        CHECK_FALSE(::can_bind_heap<::SoC::interrupt_safe_ram_heap_allocator_t, ::SoC::heap>);
+        CHECK(::SoC::is_dma_allocator<::SoC::interrupt_safe_ram_heap_allocator_t>);
+
+        auto [begin, end]{::SoC::unit_test::heap::test_fixture::get_memory()};
+        ::SoC::interrupt_safe_heap heap{begin, end};
+        auto total_pages{heap.get_free_pages()};
+        ::SoC::interrupt_safe_ram_heap_allocator_t::set_heap(heap);
+
+        constexpr auto thread_cnt{4zu};
+        constexpr auto round_cnt{4096zu};
+        ::std::atomic_size_t error_cnt{};
+        auto worker{[&error_cnt](::std::size_t seed)
+                    {
+                        using allocator_t = ::SoC::interrupt_safe_ram_heap_allocator_t;
+                        ::std::vector<::std::uint64_t*> blocks{};
+                        for(auto i{0zu}; i != round_cnt; ++i)
+                        {
+                            auto* ptr{allocator_t::allocate<::std::uint64_t>(4).ptr};
+                            ::std::ranges::fill_n(ptr, 4, seed);
+                            blocks.push_back(ptr);
+                            if(blocks.size() == 8)
+                            {
+                                for(auto* block: blocks)
+                                {
+                                    // 块内容未被其他线程改写
+                                    if(::std::ranges::count(block, block + 4, seed) != 4) { error_cnt.fetch_add(1); }
+                                    allocator_t::deallocate(block, 4);
+                                }
+                                blocks.clear();
+                            }
+                        }
+                        for(auto* block: blocks) { allocator_t::deallocate(block, 4); }
+                    }};
+
+        {
+            ::std::vector<::std::jthread> threads{};
+            for(auto i{0zu}; i != thread_cnt; ++i) { threads.emplace_back(worker, i + 1); }
+        }
+        CHECK_EQ(error_cnt.load(), 0);
+        CHECK_EQ(heap.get_free_pages(), total_pages);
+    }
+}
@@ -0,0 +1,99 @@
+/**
+ * @file heap_statistics.cpp
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief SoC::heap统计信息单元测试
+ */
+
+import "test_framework.hpp";
+import SoC.unit_test.heap;
+
+using namespace ::std::string_view_literals;
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define REGISTER_TEST_CASE(NAME) TEST_CASE("heap_statistics/" NAME)
+
+namespace
+{
+    /**
+     * @brief 将输出内容保存到字符串的文本设备
+     *
+     */
+    struct string_device
+    {
+        ::std::string content{};
+
+        void write(const char* begin, const char* end) noexcept { content.append(begin, end); }
+    };
+}  // namespace
+
+/// @test SoC::heap统计信息单元测试
+TEST_SUITE("heap_statistics" * ::doctest::description{"SoC::heap统计信息单元测试"})
+{
+    /// @test 测试分配、释放和page_gc的统计
+    REGISTER_TEST_CASE("record" * ::doctest::description{"测试分配、释放和page_gc的统计"})
+    {
+        REQUIRE(::SoC::use_heap_statistics);
+        auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
+        auto total_pages{heap.get_total_pages()};
+        constexpr auto page_class{::SoC::test::heap::statistics_t::size_class_cnt - 1};
+
+        auto statistics{heap.get_statistics()};
+        CHECK_EQ(statistics.allocate_cnt, ::SoC::test::heap::statistics_t::counter_t{});
+        CHECK_EQ(statistics.actual_bytes, 0);
+        // 初始时所有页块相邻
+        CHECK_EQ(statistics.largest_free_run, total_pages);
+
+        auto* block16{heap.allocate(10)};
+        auto* block128{heap.allocate(100)};
+        auto* pages{heap.allocate(heap.page_size + 88)};
+        statistics = heap.get_statistics();
+        CHECK_EQ(statistics.allocate_cnt[0], 1);
+        CHECK_EQ(statistics.allocate_cnt[3], 1);
+        CHECK_EQ(statistics.allocate_cnt[page_class], 1);
+        CHECK_EQ(statistics.requested_bytes, 10 + 100 + heap.page_size + 88);
+        CHECK_EQ(statistics.actual_bytes, 16 + 128 + heap.page_size * 2);
+        CHECK_EQ(statistics.peak_actual_bytes, statistics.actual_bytes);
+        // 两个块页从末尾的页块中取出，打断了连续的空闲页
+        CHECK_EQ(statistics.largest_free_run, heap.get_largest_free_run());
+        CHECK_LT(statistics.largest_free_run, total_pages);
+
+        heap.deallocate(block128, 100);
+        statistics = heap.get_statistics();
+        CHECK_EQ(statistics.deallocate_cnt[3], 1);
+        CHECK_EQ(statistics.actual_bytes, 16 + heap.page_size * 2);
+        CHECK_EQ(statistics.peak_actual_bytes, 16 + 128 + heap.page_size * 2);
+
+        CHECK_EQ(heap.page_gc(), 1);
+        statistics = heap.get_statistics();
+        CHECK_EQ(statistics.page_gc_cnt, 1);
+        CHECK_EQ(statistics.reclaimed_pages, 1);
+
+        heap.deallocate(block16, 10);
+        heap.deallocate(pages, heap.page_size + 88);
+        heap.page_gc();
+        statistics = heap.get_statistics();
+        CHECK_EQ(statistics.deallocate_cnt, statistics.allocate_cnt);
+        CHECK_EQ(statistics.requested_bytes, 0);
+        CHECK_EQ(statistics.actual_bytes, 0);
+        CHECK_EQ(statistics.page_gc_cnt, 2);
+        CHECK_EQ(statistics.reclaimed_pages, 2);
+        CHECK_EQ(statistics.largest_free_run, total_pages);
+    }
+
+    /// @test 测试通过SoC::println输出统计信息
+    REGISTER_TEST_CASE("println" * ::doctest::description{"测试通过SoC::println输出统计信息"})
+    {
+        auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
+        heap.deallocate(heap.allocate(16), 16);
+        auto* page{heap.allocate(heap.page_size)};
+
+        ::string_device device{};
+        ::SoC::println(device, heap.get_statistics());
+        auto&& content{device.content};
+        CHECK_NE(content.find("已分配: 申请512字节, 实际512字节, 峰值528字节"sv), ::std::string::npos);
+        CHECK_NE(content.find("\n16字节: 分配1次, 释放1次"sv), ::std::string::npos);
+        CHECK_NE(content.find("\n256字节: 分配0次, 释放0次"sv), ::std::string::npos);
+        CHECK_NE(content.find("\n整页: 分配1次, 释放0次"sv), ::std::string::npos);
+        CHECK(content.ends_with('\n'));
+        heap.deallocate(page, heap.page_size);
+    }
+}
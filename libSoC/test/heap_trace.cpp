@@ -0,0 +1,135 @@
+/**
+ * @file heap_trace.cpp
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief SoC::heap跟踪环单元测试
+ */
+
+import "test_framework.hpp";
+import SoC.unit_test.heap;
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define REGISTER_TEST_CASE(NAME) TEST_CASE("heap_trace/" NAME)
+
+namespace
+{
+    /**
+     * @brief 将输出内容保存到字节数组的二进制设备
+     *
+     */
+    struct byte_device
+    {
+        ::std::vector<::std::byte> content{};
+
+        void write(const ::std::byte* begin, const ::std::byte* end) noexcept { content.insert(content.end(), begin, end); }
+    };
+
+    /**
+     * @brief 转储堆跟踪环并解析转储内容
+     *
+     * @param heap 要转储的堆
+     * @return 转储头部和事件数组
+     */
+    auto dump(::SoC::test::heap& heap)
+    {
+        ::byte_device device{};
+        {
+            // 使用小缓冲区以覆盖分段写入
+            ::SoC::bin_ofile<::byte_device, ::SoC::static_buffer<::std::byte, 16>> file{device};
+            heap.dump_trace<true>(file);
+        }
+
+        auto&& content{device.content};
+        ::SoC::heap_trace_header header{};
+        REQUIRE_GE(content.size(), sizeof(header));
+        ::std::memcpy(&header, content.data(), sizeof(header));
+        ::std::vector<::SoC::heap_trace_event> events(header.event_cnt);
+        REQUIRE_EQ(content.size(), sizeof(header) + (events.size() * sizeof(::SoC::heap_trace_event)));
+        ::std::memcpy(events.data(), content.data() + sizeof(header), events.size() * sizeof(::SoC::heap_trace_event));
+        return ::std::pair{header, events};
+    }
+}  // namespace
+
+/// @test SoC::heap跟踪环单元测试
+TEST_SUITE("heap_trace" * ::doctest::description{"SoC::heap跟踪环单元测试"})
+{
+    /// @test 测试未设置缓冲区时不记录事件
+    REGISTER_TEST_CASE("disabled" * ::doctest::description{"测试未设置缓冲区时不记录事件"})
+    {
+        REQUIRE(::SoC::use_heap_trace);
+        auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
+        heap.deallocate(heap.allocate(16), 16);
+
+        auto [header, events]{::dump(heap)};
+        CHECK_EQ(header.magic, ::SoC::heap_trace_header::magic_value);
+        CHECK_EQ(header.event_cnt, 0);
+        CHECK_EQ(header.dropped_cnt, 0);
+    }
+
+    /// @test 测试记录事件并按时间顺序转储
+    REGISTER_TEST_CASE("record" * ::doctest::description{"测试记录事件并按时间顺序转储"})
+    {
+        auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
+        ::std::array<::SoC::heap_trace_event, 4> buffer{};
+        heap.set_trace_buffer(buffer);
+
+        auto* block16{heap.allocate(10)};
+        auto* page{heap.allocate(heap.page_size)};
+        heap.deallocate(block16, 10);
+
+        auto [header, events]{::dump(heap)};
+        CHECK_EQ(header.event_cnt, 3);
+        CHECK_EQ(header.dropped_cnt, 0);
+        REQUIRE_EQ(events.size(), 3);
+        CHECK_FALSE(events[0].is_deallocate());
+        CHECK_EQ(events[0].get_size(), 10);
+        CHECK_FALSE(events[1].is_deallocate());
+        CHECK_EQ(events[1].get_size(), heap.page_size);
+        // 整页分配的偏移量按页对齐
+        CHECK_EQ(events[1].offset % heap.page_size, 0);
+        CHECK(events[2].is_deallocate());
+        CHECK_EQ(events[2].get_size(), 10);
+        CHECK_EQ(events[2].offset, events[0].offset);
+        CHECK_NE(events[1].offset, events[0].offset);
+
+        heap.deallocate(page, heap.page_size);
+        heap.set_trace_buffer({});
+    }
+
+    /// @test 测试缓冲区写满后覆盖最早的事件
+    REGISTER_TEST_CASE("wrap" * ::doctest::description{"测试缓冲区写满后覆盖最早的事件"})
+    {
+        auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
+        ::std::array<::SoC::heap_trace_event, 4> buffer{};
+        heap.set_trace_buffer(buffer);
+
+        // 共6个事件，最早的2个被覆盖
+        auto* block16{heap.allocate(16)};
+        auto* block128{heap.allocate(100)};
+        heap.deallocate(block16, 16);
+        auto* block32{heap.allocate(32)};
+        heap.deallocate(block128, 100);
+        heap.deallocate(block32, 32);
+
+        auto [header, events]{::dump(heap)};
+        CHECK_EQ(header.event_cnt, 4);
+        CHECK_EQ(header.dropped_cnt, 2);
+        REQUIRE_EQ(events.size(), 4);
+        constexpr ::std::array expected{
+            ::std::pair{true, 16U},
+            ::std::pair{false, 32U},
+            ::std::pair{true, 100U},
+            ::std::pair{true, 32U},
+        };
+        for(auto&& [event, expected_event]: ::std::views::zip(events, expected))
+        {
+            CHECK_EQ(event.is_deallocate(), expected_event.first);
+            CHECK_EQ(event.get_size(), expected_event.second);
+        }
+        CHECK_EQ(events[3].offset, events[1].offset);
+        CHECK_NE(events[2].offset, events[1].offset);
+
+        // 系统时刻单调不减
+        CHECK(::std::ranges::is_sorted(events, {}, &::SoC::heap_trace_event::systick));
+        heap.set_trace_buffer({});
+    }
+}
@@ -55,15 +55,13 @@ TEST_SUITE("heap_utils" * ::doctest::description{"SoC::heap实用函数单元测
         /// 测试metadata初始化是否正确
         SUBCASE("metadata")
         {
-            void* page_begin{heap.data};
-            auto space_left{::SoC::unit_test::heap::heap_size - page_num * sizeof(::SoC::unit_test::heap::metadata_t)};
+            void* page_begin{heap.bitmaps + (heap.bitmap_cnt * heap.bitmap_words)};
+            auto space_left{::SoC::unit_test::heap::heap_size - page_num * sizeof(::SoC::unit_test::heap::metadata_t) -
+                            heap.bitmap_cnt * heap.bitmap_words * sizeof(::SoC::test::heap::bitmap_word_t)};
             REQUIRE_NE(::std::align(heap.page_size, page_num * heap.page_size, page_begin, space_left), nullptr);
             auto current_page_address{::std::bit_cast<::std::uintptr_t>(page_begin)};
             for(auto&& metadata: heap.metadata)
             {
-                // 除了最后一页，其他页的next_page都指向后一页的metadata
-                auto* next_page{&metadata != &heap.metadata.back() ? &metadata + 1 : nullptr};
-                CHECK_EQ(metadata.next_page, next_page);
                 // 每一页的free_block_list都指向当前页的首地址
                 CHECK_EQ(metadata.free_block_list,
                          ::std::bit_cast<::SoC::unit_test::heap::free_block_list_t*>(current_page_address));
@@ -75,8 +73,52 @@ TEST_SUITE("heap_utils" * ::doctest::description{"SoC::heap实用函数单元测
             }
         }
 
-        /// 测试空闲页链表初始化是否正确
-        SUBCASE("free_page_list") { CHECK_EQ(heap.free_page_list.back(), heap.metadata.data()); }
+        /// 测试位图初始化是否正确
+        SUBCASE("bitmap")
+        {
+            // 位图区紧跟在元数据区之后
+            CHECK_EQ(static_cast<void*>(heap.bitmaps), static_cast<void*>(heap.metadata.data() + page_num));
+            CHECK_EQ(heap.bitmap_words, (page_num + heap.bitmap_word_bits - 1) / heap.bitmap_word_bits);
+            // 所有页都空闲且未分块
+            for(auto page_index{0zu}; page_index != heap.bitmap_words * heap.bitmap_word_bits; ++page_index)
+            {
+                CAPTURE(page_index);
+                CHECK_EQ(heap.test_bit(heap.get_free_page_bitmap(), page_index), page_index < page_num);
+            }
+            for(auto free_list_index{0zu}; free_list_index != heap.free_page_list.size(); ++free_list_index)
+            {
+                CAPTURE(free_list_index);
+                CHECK(::std::ranges::all_of(heap.get_empty_page_bitmap(free_list_index),
+                                            [](auto word) static noexcept { return word == 0; }));
+            }
+        }
+
+        /// 测试块空闲链表初始化是否正确
+        SUBCASE("free_page_list")
+        {
+            for(auto* free_page_list: heap.free_page_list) { CHECK_EQ(free_page_list, nullptr); }
+        }
+
+        /// 测试伙伴系统初始化是否正确
+        SUBCASE("free_run_list")
+        {
+            // 所有页都应划分为对齐的页块放入伙伴系统
+            CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), page_num);
+            auto free_run_cnt{0zu};
+            for(auto&& [order, head]: ::std::views::zip(::std::views::iota(0zu), heap.free_run_list))
+            {
+                CAPTURE(order);
+                if(head == nullptr) { continue; }
+                // 初始化时每阶至多有一个页块
+                CHECK_EQ(head->next_page, nullptr);
+                CHECK_EQ(head->prev_page, nullptr);
+                // 页块首页索引对齐到页块大小
+                CHECK_EQ(static_cast<::std::size_t>(head - heap.metadata.data()) % (1zu << order), 0);
+                ++free_run_cnt;
+            }
+            // 页块数量等于页数中1的个数
+            CHECK_EQ(free_run_cnt, static_cast<::std::size_t>(::std::popcount(page_num)));
+        }
     }
 
     /// @test 测试堆的获取实际分配大小函数能否正常工作
@@ -122,12 +164,17 @@ TEST_SUITE("heap_utils" * ::doctest::description{"SoC::heap实用函数单元测
         SUBCASE("get_total_pages") { CHECK_EQ(heap.get_total_pages(), total_page_cnt_gt); }
 
         constexpr auto using_page_cnt_gt{10zu};
-        ::std::uniform_int_distribution<::std::ptrdiff_t> page_index_range{0,
-                                                                           static_cast<::std::ptrdiff_t>(total_page_cnt_gt - 1)};
+        ::std::uniform_int_distribution<::std::size_t> page_cnt_range{1, 4};
         auto seed{::doctest::getContextOptions()->rand_seed};
         CAPTURE(seed);
         ::std::default_random_engine random_engine{seed};
-        for(auto _: ::std::views::iota(0zu, using_page_cnt_gt)) { ++heap.metadata[page_index_range(random_engine)].used_block; }
+        // 随机分配若干次连续页，共占用using_page_cnt_gt页
+        for(auto using_page_cnt{0zu}; using_page_cnt != using_page_cnt_gt;)
+        {
+            auto page_cnt{::std::min(page_cnt_range(random_engine), using_page_cnt_gt - using_page_cnt)};
+            auto* _{heap.allocate(heap.page_size * page_cnt)};
+            using_page_cnt += page_cnt;
+        }
 
         SUBCASE("get_using_pages") { CHECK_EQ(heap.get_using_pages(), using_page_cnt_gt); }
 
@@ -196,22 +243,23 @@ TEST_SUITE("heap_utils" * ::doctest::description{"SoC::heap实用函数单元测
      * @brief 为测试堆的插入块函数准备堆
      *
      * @param heap 堆对象
-     * @return std::array<metadata_t*, 2> 空闲页链表的第一页、第二页
+     * @return std::array<metadata_t*, 2> 空闲块链表的第一页、第二页
      */
     ::std::array<::SoC::unit_test::heap::metadata_t*, 2> make_heap_for_insert_block_into_page_list_test(::SoC::test::heap & heap)
     {
-        auto&& free_page_list{heap.free_page_list.back()};
-        auto* first_page{free_page_list};
-        auto* second_page{first_page->next_page};
-        // 将空闲页链表的头指针指向第三页，将第一页插入空闲块链表
-        // 即将空闲页链表的前两页放入空闲块链表
-        heap.free_page_list.front() = ::std::exchange(free_page_list, second_page->next_page);
-        // 将第二页设为空闲块链表的尾节点
-        second_page->next_page = nullptr;
-
-        // 设置块大小
-        first_page->block_size_shift = heap.min_block_shift;
-        second_page->block_size_shift = heap.min_block_shift;
+        // 在16字节块链表中放入两个空页
+        auto* second_page{heap.pop_free_run(0)};
+        auto* first_page{heap.pop_free_run(0)};
+        heap.free_page_list.front() = first_page;
+        first_page->next_page = second_page;
+        second_page->prev_page = first_page;
+
+        for(auto* page: {first_page, second_page})
+        {
+            // 设置块大小
+            page->block_size_shift = heap.min_block_shift;
+            heap.set_bit(heap.get_empty_page_bitmap(0), heap.get_page_index(page));
+        }
         return {first_page, second_page};
     }
 
@@ -223,19 +271,23 @@ TEST_SUITE("heap_utils" * ::doctest::description{"SoC::heap实用函数单元测
      */
     void do_insert_block_into_page_list_test(::SoC::test::heap & heap, ::SoC::unit_test::heap::metadata_t * page_ptr)
     {
-        auto&& free_page_list{heap.free_page_list.back()};
-        // 记录空闲页链表的头指针的期望值
-        auto* free_page_list_head_gt{free_page_list};
-        // 记录下一个页的元数据指针的期望值
-        auto* next_page_gt{page_ptr->next_page};
-        auto* next_page{heap.insert_block_into_page_list(page_ptr)};
-
-        // 检查返回值是否正确，即下一个页的元数据指针
-        CHECK_EQ(next_page, next_page_gt);
-        // 检查页是否插入空闲页链表的头部
-        CHECK_EQ(page_ptr, free_page_list);
-        // 检查新插入的页的next_page是否指向了原空闲页链表的头指针，即是否成功穿成链表
-        CHECK_EQ(page_ptr->next_page, free_page_list_head_gt);
+        auto free_run_pages_gt{::SoC::unit_test::heap::get_free_run_pages(heap) + 1};
+        auto* prev_page{page_ptr->prev_page};
+        auto* next_page{page_ptr->next_page};
+        heap.insert_block_into_page_list(page_ptr, 0);
+
+        // 检查页是否从块空闲链表中删除
+        if(prev_page == nullptr) { CHECK_EQ(heap.free_page_list.front(), next_page); }
+        else
+        {
+            CHECK_EQ(prev_page->next_page, next_page);
+        }
+        if(next_page != nullptr) { CHECK_EQ(next_page->prev_page, prev_page); }
+        CHECK_FALSE(heap.test_bit(heap.get_empty_page_bitmap(0), heap.get_page_index(page_ptr)));
+        // 检查页是否归还伙伴系统，两页的伙伴都不空闲，因此不会合并
+        CHECK_EQ(page_ptr, heap.free_run_list[0]);
+        CHECK_EQ(page_ptr->order, 0);
+        CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), free_run_pages_gt);
         auto metadata_index{::std::distance(heap.metadata.data(), page_ptr)};
         auto data_address{::std::bit_cast<::std::uintptr_t>(heap.data) + metadata_index * heap.page_size};
         // 检查页的空闲块指针是否指向数据块首地址，并且next为nullptr，即完成对于页操作的初始化
@@ -264,69 +316,137 @@ TEST_SUITE("heap_utils" * ::doctest::description{"SoC::heap实用函数单元测
         }
     }
 
-    /// @test 测试从空闲页链表中移除范围内的页
-    REGISTER_TEST_CASE("remove_pages" * ::doctest::description{"测试从空闲页链表中移除范围内的页"})
+    /// @test 测试伙伴系统的拆分与合并
+    REGISTER_TEST_CASE("free_run" * ::doctest::description{"测试伙伴系统的拆分与合并"})
     {
         auto heap{::SoC::unit_test::heap::test_fixture::get_heap()};
-        auto&& free_page_list{heap.free_page_list.back()};
-        auto* first_page{free_page_list};
-        auto* second_page{first_page->next_page};
-        auto* third_page{second_page->next_page};
-        auto* fourth_page{third_page->next_page};
+        auto free_run_list_gt{heap.free_run_list};
+        auto total_pages{heap.get_total_pages()};
+        // 最大的页块位于堆首
+        auto top_order{static_cast<::std::size_t>(::std::bit_width(total_pages) - 1)};
+        REQUIRE_EQ(heap.free_run_list[top_order], heap.metadata.data());
 
-        SUBCASE("remove pages with free_page_list head")
+        SUBCASE("split and coalesce")
         {
-            // 检查返回值是否为范围内的首个页
-            auto* block_ptr{first_page->free_block_list};
-            CHECK_EQ(heap.remove_pages(block_ptr, third_page->free_block_list), block_ptr);
-            // 检查空闲页表头是否为第四页
-            CHECK_EQ(heap.free_page_list.back(), third_page->next_page);
-            // 检查范围内的页used_blocks是否为1
-            CHECK_EQ(first_page->used_block, 1);
-            CHECK_EQ(second_page->used_block, 1);
-            CHECK_EQ(third_page->used_block, 1);
-            CHECK_EQ(fourth_page->used_block, 0);
-            // 检查范围内的页free_block_list是否为nullptr
-            CHECK_EQ(first_page->free_block_list, nullptr);
-            CHECK_EQ(second_page->free_block_list, nullptr);
-            CHECK_EQ(third_page->free_block_list, nullptr);
-            CHECK_NE(fourth_page->free_block_list, nullptr);
+            // 取出最大的页块后归还，伙伴系统应恢复原状
+            auto* first_page{heap.pop_free_run(top_order)};
+            REQUIRE_EQ(first_page, heap.metadata.data());
+            CHECK_EQ(first_page->order, heap.invalid_order);
+            heap.push_free_run(first_page, top_order);
+            REQUIRE_EQ(heap.free_run_list, free_run_list_gt);
+
+            // 只保留堆首的页块，从中取出1页，其余部分按阶数归还
+            ::SoC::unit_test::heap::clear_free_run_list(heap);
+            heap.push_free_run(first_page, top_order);
+            CHECK_EQ(heap.pop_free_run(0), first_page);
+            for(auto order{0zu}; order != top_order; ++order)
+            {
+                CAPTURE(order);
+                auto* buddy{first_page + (1zu << order)};
+                CHECK_EQ(heap.free_run_list[order], buddy);
+                CHECK_EQ(buddy->order, order);
+            }
+            CHECK_EQ(heap.free_run_list[top_order], nullptr);
+
+            // 归还后逐级与伙伴合并
+            heap.push_free_run(first_page, 0);
+            for(auto order{0zu}; order != top_order; ++order) { CHECK_EQ(heap.free_run_list[order], nullptr); }
+            CHECK_EQ(heap.free_run_list[top_order], first_page);
+            CHECK_EQ(first_page->order, top_order);
         }
 
-        SUBCASE("remove pages without free_page_list head")
+        SUBCASE("no enough pages")
         {
-            auto* block_ptr{second_page->free_block_list};
-            auto do_check{[&]
-                          {
-                              // 检查返回值是否为范围内的首个页
-                              CHECK_EQ(heap.remove_pages(block_ptr, third_page->free_block_list), block_ptr);
-                              // 检查空闲页表头是否为第一页
-                              CHECK_EQ(heap.free_page_list.back(), first_page);
-                              // 检查范围内的页used_blocks是否为1，不在移除范围内的页used_blocks是否为0
-                              CHECK_EQ(first_page->used_block, 0);
-                              CHECK_EQ(second_page->used_block, 1);
-                              CHECK_EQ(third_page->used_block, 1);
-                              CHECK_EQ(fourth_page->used_block, 0);
-                              // 检查范围内的页free_block_list是否为nullptr，不在移除范围内的页free_block_list是否为非nullptr
-                              CHECK_NE(first_page->free_block_list, nullptr);
-                              CHECK_EQ(second_page->free_block_list, nullptr);
-                              CHECK_EQ(third_page->free_block_list, nullptr);
-                              CHECK_NE(fourth_page->free_block_list, nullptr);
-                          }};
-
-            SUBCASE("in order") { do_check(); }
-
-            SUBCASE("out of order")
+            CHECK_EQ(heap.pop_free_run(top_order + 1), nullptr);
+            CHECK_EQ(heap.pop_free_run(heap.max_order + 1), nullptr);
+            CHECK_EQ(heap.free_run_list, free_run_list_gt);
+        }
+
+        SUBCASE("release pages")
+        {
+            auto* first_page{heap.pop_free_run(top_order)};
+            // 释放除首页外的所有页，按地址对齐拆分为页块
+            heap.release_pages(1, (1zu << top_order) - 1);
+            for(auto order{0zu}; order != top_order; ++order)
             {
-                // 交换first_page和fourth_page以测试链表穿插的情况
-                first_page->next_page = fourth_page->next_page;
-                fourth_page->next_page = second_page;
-                third_page->next_page = first_page;
-                ::std::ranges::swap(first_page, fourth_page);
-                free_page_list = first_page;
-
-                do_check();
+                CAPTURE(order);
+                CHECK_EQ(heap.free_run_list[order], first_page + (1zu << order));
             }
+            CHECK_EQ(heap.free_run_list[top_order], nullptr);
+            CHECK_EQ(first_page->order, heap.invalid_order);
+
+            // 释放首页后合并为完整的页块
+            heap.release_pages(0, 1);
+            CHECK_EQ(heap.free_run_list, free_run_list_gt);
+            CHECK_EQ(::SoC::unit_test::heap::get_free_run_pages(heap), total_pages);
+        }
+    }
+
+    /// @test 测试不同几何参数的堆能否正常工作
+    REGISTER_TEST_CASE("geometry" * ::doctest::description{"测试不同几何参数的堆能否正常工作"})
+    {
+        using heap_t = ::SoC::ccmram_heap;
+        static_assert(heap_t::min_block_size == 8 && heap_t::page_size == 1024);
+        static_assert(heap_t::get_actual_allocate_size(1) == 8);
+        static_assert(heap_t::get_actual_allocate_size(600) == heap_t::page_size);
+        static_assert(heap_t::get_actual_allocate_size(heap_t::page_size + 1) == heap_t::page_size * 2);
+        static_assert(heap_t::statistics_t::size_class_cnt == 8);
+
+        // 夹具提供的内存只对齐到默认页大小，因此单独分配
+        constexpr auto heap_size{16 * 1024zu};
+        auto space{heap_size + heap_t::page_size};
+        // NOLINTNEXTLINE(*-avoid-c-arrays)
+        auto memory{::std::make_unique<::std::uintptr_t[]>(space / sizeof(::std::uintptr_t))};
+        void* ptr{memory.get()};
+        REQUIRE_NE(::std::align(heap_t::page_size, heap_size, ptr, space), nullptr);
+        auto* begin{static_cast<::std::uintptr_t*>(ptr)};
+        heap_t heap{begin, begin + (heap_size / sizeof(::std::uintptr_t))};
+        auto free_pages{heap.get_free_pages()};
+        CHECK_EQ(free_pages, heap.get_total_pages());
+
+        auto* block8{heap.allocate(5)};
+        auto* block512{heap.allocate(500)};
+        auto* page{heap.allocate(heap_t::page_size)};
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+        CHECK_EQ(reinterpret_cast<::std::uintptr_t>(block8) % 8, 0);
+        CHECK_EQ(reinterpret_cast<::std::uintptr_t>(block512) % 512, 0);
+        CHECK_EQ(reinterpret_cast<::std::uintptr_t>(page) % heap_t::page_size, 0);
+        // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+        CHECK_EQ(heap.get_using_pages(), 3);
+
+        heap.deallocate(block8, 5);
+        heap.deallocate(block512, 500);
+        heap.deallocate(page, heap_t::page_size);
+        // 页空闲位图不区分是否分块，因此无需page_gc
+        CHECK_EQ(heap.get_free_pages(), free_pages);
+    }
+
+    /// @test 测试使用紧凑页元数据的堆能否正常工作
+    REGISTER_TEST_CASE("compact metadata" * ::doctest::description{"测试使用紧凑页元数据的堆能否正常工作"})
+    {
+        static_assert(sizeof(::SoC::detail::compact_heap_page_metadata) == 8);
+        auto [begin, end]{::SoC::unit_test::heap::test_fixture::get_memory()};
+        auto total_pages{::SoC::heap{begin, end}.get_total_pages()};
+        ::SoC::compact_heap heap{begin, end};
+        // 元数据区减小后可容纳更多页
+        CHECK_GT(heap.get_total_pages(), total_pages);
+        auto free_pages{heap.get_free_pages()};
+        CHECK_EQ(free_pages, heap.get_total_pages());
+
+        // 同一页内的块按地址顺序分配，释放后后进先出复用
+        ::std::array<void*, 4> blocks{};
+        for(auto&& block: blocks) { block = heap.allocate(16); }
+        for(auto i{1zu}; i != blocks.size(); ++i)
+        {
+            CHECK_EQ(static_cast<::std::byte*>(blocks[i]) - static_cast<::std::byte*>(blocks[i - 1]), 16);
         }
+        heap.deallocate(blocks[1], 16);
+        CHECK_EQ(heap.allocate(10), blocks[1]);
+
+        auto* pages{heap.allocate(heap.page_size * 3)};
+        CHECK_EQ(heap.get_using_pages(), 4);
+        heap.deallocate(pages, heap.page_size * 3);
+        for(auto* block: blocks) { heap.deallocate(block, 16); }
+        CHECK_EQ(heap.get_free_pages(), free_pages);
     }
 }
@@ -0,0 +1,95 @@
+/**
+ * @file monotonic_arena.cpp
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief 测试单调分配器
+ */
+
+import "test_framework.hpp";
+import SoC.unit_test;
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define REGISTER_TEST_CASE(NAME) TEST_CASE("monotonic_arena/" NAME)
+
+namespace
+{
+    using arena_t = ::SoC::monotonic_arena_allocator<struct arena_tag>;
+}  // namespace
+
+/// @test 测试单调分配器
+TEST_SUITE("monotonic_arena" * ::doctest::description{"测试单调分配器"})
+{
+    /// @test 测试分配器满足静态分配器约束
+    REGISTER_TEST_CASE("concept" * ::doctest::description{"测试分配器满足静态分配器约束"})
+    {
+        CHECK(::SoC::is_static_allocator<::arena_t>);
+        CHECK(::std::is_empty_v<::arena_t>);
+    }
+
+    /// @test 测试在缓冲区中连续分配并一次性回收
+    REGISTER_TEST_CASE("allocate" * ::doctest::description{"测试在缓冲区中连续分配并一次性回收"})
+    {
+        alignas(::std::max_align_t)::std::array<::std::byte, 256> buffer{};
+        ::arena_t::set_buffer(buffer);
+        CHECK_EQ(::arena_t::remaining(), buffer.size());
+
+        auto ptr1{::arena_t::allocate<char>()};
+        CHECK_EQ(static_cast<void*>(ptr1), buffer.data());
+        // 按类型对齐
+        auto ptr2{::arena_t::allocate<::std::uint32_t>()};
+        CHECK_EQ(reinterpret_cast<::std::byte*>(ptr2), buffer.data() + 4);
+        auto [ptr3, n]{::arena_t::allocate<::std::uint16_t>(3)};
+        CHECK_EQ(n, 3);
+        CHECK_EQ(reinterpret_cast<::std::byte*>(ptr3), buffer.data() + 8);
+        CHECK_EQ(::arena_t::used(), 14);
+
+        // 释放不回收内存
+        ::arena_t::deallocate(ptr2);
+        CHECK_EQ(::arena_t::used(), 14);
+        ::arena_t::reset();
+        CHECK_EQ(::arena_t::used(), 0);
+
+        CHECK_EQ(::arena_t::allocate(200), buffer.data());
+        CHECK_THROWS_WITH_AS_MESSAGE(::arena_t::allocate(100),
+                                     ::doctest::Contains{"单调分配器剩余空间不足"},
+                                     ::SoC::assert_failed_exception,
+                                     "剩余空间不足时分配应断言失败");
+        CHECK_EQ(::arena_t::used(), 200);
+    }
+
+    /// @test 测试作用域结束时回收作用域内的分配
+    REGISTER_TEST_CASE("scope" * ::doctest::description{"测试作用域结束时回收作用域内的分配"})
+    {
+        alignas(::std::max_align_t)::std::array<::std::byte, 256> buffer{};
+        ::arena_t::set_buffer(buffer);
+        ::arena_t::allocate<::std::uint64_t>();
+        {
+            ::arena_t::scope outer{};
+            ::arena_t::allocate<::std::uint64_t>(4);
+            {
+                ::arena_t::scope inner{};
+                ::arena_t::allocate<::std::byte>(64);
+                CHECK_EQ(::arena_t::used(), 104);
+            }
+            CHECK_EQ(::arena_t::used(), 40);
+        }
+        CHECK_EQ(::arena_t::used(), 8);
+    }
+
+    /// @test 测试从上游分配器获取缓冲区
+    REGISTER_TEST_CASE("buffer_guard" * ::doctest::description{"测试从上游分配器获取缓冲区"})
+    {
+        ::SoC::std_allocator::reset();
+        alignas(::std::max_align_t)::std::array<::std::byte, 64> buffer{};
+        ::arena_t::set_buffer(buffer);
+        ::arena_t::allocate(16);
+        {
+            ::arena_t::buffer_guard<::SoC::std_allocator> guard{1024};
+            CHECK_EQ(::SoC::std_allocator::allocate_cnt, 1);
+            CHECK_EQ(::arena_t::remaining(), 1024);
+            ::arena_t::allocate(512);
+        }
+        CHECK_EQ(::SoC::std_allocator::deallocate_cnt, 1);
+        CHECK_EQ(::arena_t::get_buffer().data(), buffer.data());
+        CHECK_EQ(::arena_t::used(), 16);
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file object_pool.cpp
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief 测试定长对象池
+ */
+
+import "test_framework.hpp";
+import SoC.unit_test;
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define REGISTER_TEST_CASE(NAME) TEST_CASE("object_pool/" NAME)
+
+namespace
+{
+    /**
+     * @brief 24字节的消息对象
+     *
+     */
+    struct message
+    {
+        ::std::uint64_t id;
+        ::std::uint64_t timestamp;
+        ::std::uint32_t payload;
+    };
+
+    using pool_t = ::SoC::object_pool<::message, 3>;
+}  // namespace
+
+/// @test 测试定长对象池
+TEST_SUITE("object_pool" * ::doctest::description{"测试定长对象池"})
+{
+    /// @test 测试对象池满足静态分配器约束
+    REGISTER_TEST_CASE("concept" * ::doctest::description{"测试对象池满足静态分配器约束"})
+    {
+        CHECK(::SoC::is_static_allocator<::pool_t>);
+        CHECK(::std::is_empty_v<::pool_t>);
+        CHECK_EQ(::pool_t::capacity(), 3);
+    }
+
+    /// @test 测试分配和释放槽
+    REGISTER_TEST_CASE("allocate" * ::doctest::description{"测试分配和释放槽"})
+    {
+        auto ptr1{::pool_t::allocate<::message>()};
+        auto ptr2{::pool_t::allocate<::message>()};
+        auto ptr3{::pool_t::allocate(sizeof(::message))};
+        CHECK_EQ(::pool_t::size(), 3);
+        // 槽大小与对象大小相同，不向上取整
+        CHECK_EQ(reinterpret_cast<::std::byte*>(ptr2) - reinterpret_cast<::std::byte*>(ptr1), sizeof(::message));
+        CHECK_THROWS_WITH_AS_MESSAGE(::pool_t::allocate<::message>(),
+                                     ::doctest::Contains{"对象池已用尽"},
+                                     ::SoC::assert_failed_exception,
+                                     "对象池用尽时分配应断言失败");
+
+        // 后进先出复用空闲槽
+        ::pool_t::deallocate(ptr1);
+        ::pool_t::deallocate(ptr3, sizeof(::message));
+        CHECK_EQ(::pool_t::size(), 1);
+        CHECK_EQ(::pool_t::allocate(8), ptr3);
+        auto [ptr4, n]{::pool_t::allocate<::std::uint32_t>(2)};
+        CHECK_EQ(ptr4, static_cast<void*>(ptr1));
+        CHECK_EQ(n, sizeof(::message) / sizeof(::std::uint32_t));
+
+        CHECK_THROWS_WITH_AS_MESSAGE(::pool_t::deallocate(&ptr1->payload),
+                                     ::doctest::Contains{"要释放的指针不属于对象池"},
+                                     ::SoC::assert_failed_exception,
+                                     "释放不属于对象池的指针应断言失败");
+        ::pool_t::deallocate(ptr2);
+        ::pool_t::deallocate(ptr3, 8);
+        ::pool_t::deallocate(ptr4, 2);
+        CHECK_EQ(::pool_t::size(), 0);
+    }
+
+    /// @test 测试对象池作为智能指针的分配器
+    REGISTER_TEST_CASE("unique_ptr" * ::doctest::description{"测试对象池作为智能指针的分配器"})
+    {
+        {
+            ::SoC::unique_ptr<::message, ::pool_t> ptr{::pool_t::allocate<::message>(), ::pool_t{}};
+            ptr->id = 1;
+            CHECK_EQ(::pool_t::size(), 1);
+        }
+        CHECK_EQ(::pool_t::size(), 0);
+    }
+}
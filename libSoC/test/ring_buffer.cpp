@@ -721,6 +721,143 @@ TEST_SUITE("ring_buffer" * ::doctest::description{"测试环形缓冲区"})
         CHECK_EQ(buffer1, buffer2);
     }
 
+    /// @test 测试环形缓冲区的批量操作
+    REGISTER_TEST_CASE("bulk" * ::doctest::description{"测试环形缓冲区的批量操作"})
+    {
+        SUBCASE("trivially copyable")
+        {
+            ::SoC::test::ring_buffer<::std::uint8_t, 8> buffer{};
+            // 从接近末尾处开始，使批量操作发生回绕
+            buffer.head = 6;
+            buffer.tail = 6;
+            constexpr ::std::array<::std::uint8_t, 5> input{1, 2, 3, 4, 5};
+            buffer.push_back_range(input);
+            CHECK_EQ(buffer.size(), input.size());
+            CHECK(::std::ranges::equal(buffer, input));
+
+            ::std::array<::std::uint8_t, 3> output{};
+            buffer.pop_front_into(output);
+            CHECK_EQ(output, ::std::array<::std::uint8_t, 3>{1, 2, 3});
+            buffer.discard(1);
+            CHECK_EQ(buffer.size(), 1);
+            CHECK_EQ(buffer.front(), 5);
+
+            CHECK_THROWS_WITH_AS_MESSAGE(buffer.push_back_range(::std::array<::std::uint8_t, 8>{}),
+                                         ::doctest::Contains{"环形缓冲区剩余空间不足"},
+                                         ::SoC::assert_failed_exception,
+                                         "添加的元素超过剩余空间应断言失败"sv);
+            CHECK_THROWS_WITH_AS_MESSAGE(buffer.pop_front_into(output),
+                                         ::doctest::Contains{"环形缓冲区中的元素不足"},
+                                         ::SoC::assert_failed_exception,
+                                         "取出的元素超过已有元素应断言失败"sv);
+            CHECK_THROWS_WITH_AS_MESSAGE(buffer.discard(2),
+                                         ::doctest::Contains{"环形缓冲区中的元素不足"},
+                                         ::SoC::assert_failed_exception,
+                                         "丢弃的元素超过已有元素应断言失败"sv);
+        }
+
+        SUBCASE("non-trivial")
+        {
+            ::ring_buffer_t buffer{};
+            buffer.head = -1zu - 1;
+            buffer.tail = buffer.head;
+            const ::std::array<::test_struct, 3> input{1zu, 2zu, 3zu};
+            ::test_struct::reset();
+            buffer.push_back_range(input);
+            CHECK_EQ(::test_struct::copy_ctor_cnt, 3);
+            CHECK(::std::ranges::equal(buffer, input));
+
+            ::std::array<::test_struct, 2> output{};
+            ::test_struct::reset();
+            buffer.pop_front_into(output);
+            CHECK_EQ(output[0], 1zu);
+            CHECK_EQ(output[1], 2zu);
+            CHECK_EQ(::test_struct::dtor_cnt, 2);
+            buffer.discard(1);
+            CHECK_EQ(::test_struct::dtor_cnt, 3);
+            CHECK(buffer.empty());
+        }
+    }
+
+    /// @test 测试环形缓冲区的连续读写区域
+    REGISTER_TEST_CASE("region" * ::doctest::description{"测试环形缓冲区的连续读写区域"})
+    {
+        ::SoC::test::ring_buffer<char, 8> buffer{};
+        buffer.head = 3;
+        buffer.tail = 3;
+        // 可写区域在缓冲区末尾截断
+        auto region{buffer.write_region()};
+        CHECK_EQ(region.data(), &buffer.buffer[3].value);
+        REQUIRE_EQ(region.size(), 5);
+        auto [ptr, ec]{::std::to_chars(region.data(), region.data() + region.size(), 1234)};
+        REQUIRE_EQ(ec, ::std::errc{});
+        buffer.commit(ptr - region.data());
+        CHECK(::std::ranges::equal(buffer, "1234"sv));
+
+        // 回绕后可写区域从缓冲区开头开始
+        buffer.commit(buffer.write_region().size());
+        CHECK_EQ(buffer.write_region().data(), &buffer.buffer[0].value);
+        CHECK_EQ(buffer.write_region().size(), 3);
+        CHECK_THROWS_WITH_AS_MESSAGE(buffer.commit(4),
+                                     ::doctest::Contains{"提交的元素数超过连续可写区域"},
+                                     ::SoC::assert_failed_exception,
+                                     "提交的元素超过连续可写区域应断言失败"sv);
+
+        // 可读区域同样在缓冲区末尾截断
+        auto readable{buffer.read_region()};
+        CHECK_EQ(readable.size(), 5);
+        CHECK(::std::ranges::equal(readable.first(4), "1234"sv));
+        CHECK_THROWS_WITH_AS_MESSAGE(buffer.consume(6),
+                                     ::doctest::Contains{"释放的元素数超过连续可读区域"},
+                                     ::SoC::assert_failed_exception,
+                                     "释放的元素超过连续可读区域应断言失败"sv);
+        buffer.consume(readable.size());
+        CHECK(buffer.empty());
+        CHECK(buffer.read_region().empty());
+
+        buffer.head = 0;
+        buffer.tail = 8;
+        CHECK(buffer.write_region().empty());
+        CHECK_EQ(buffer.read_region().size(), 8);
+    }
+
+    /// @test 测试环形缓冲区的分段访问和分段算法
+    REGISTER_TEST_CASE("segments" * ::doctest::description{"测试环形缓冲区的分段访问和分段算法"})
+    {
+        ::SoC::test::ring_buffer<int, 8> buffer{};
+        // 未回绕时第二段为空
+        for(auto i{1}; i != 4; ++i) { buffer.emplace_back(i); }
+        auto [first, second]{buffer.segments()};
+        CHECK_EQ(first.data(), &buffer.buffer[0].value);
+        CHECK(::std::ranges::equal(first, ::std::array{1, 2, 3}));
+        CHECK(second.empty());
+
+        // 回绕时依次为头部到缓冲区末尾、缓冲区开头到尾部两段
+        buffer.discard(3);
+        for(auto i{1}; i != 9; ++i) { buffer.emplace_back(i); }
+        auto&& const_buffer{::std::as_const(buffer)};
+        auto [const_first, const_second]{const_buffer.segments()};
+        CHECK(::std::same_as<decltype(const_first), ::std::span<const int>>);
+        CHECK_EQ(const_first.size(), 5);
+        CHECK_EQ(const_second.size(), 3);
+        CHECK_EQ(const_second.data(), &buffer.buffer[0].value);
+
+        ::std::array<int, 8> output{};
+        CHECK_EQ(::SoC::copy(const_buffer, output.begin()), output.end());
+        CHECK(::std::ranges::equal(output, buffer));
+        CHECK_EQ(::SoC::fold(const_buffer, 0, ::std::plus<>{}), 36);
+        // 折叠按从头到尾的顺序进行
+        CHECK_EQ(::SoC::fold(const_buffer, 0, [](int acc, int value) { return acc * 10 + value; }), 12345678);
+
+        ::SoC::for_each(buffer, [](int& value) { value *= 2; });
+        CHECK(::std::ranges::equal(buffer, ::std::array{2, 4, 6, 8, 10, 12, 14, 16}));
+
+        buffer.discard(buffer.size());
+        CHECK(buffer.segments()[0].empty());
+        CHECK(buffer.segments()[1].empty());
+        CHECK_EQ(::SoC::fold(buffer, 0, ::std::plus<>{}), 0);
+    }
+
     /// @test 测试环形缓冲区的交换函数
     REGISTER_TEST_CASE("swap" * ::doctest::description{"测试环形缓冲区的交换函数"})
     {
@@ -0,0 +1,120 @@
+/**
+ * @file routing_allocator.cpp
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief 测试内存访问能力标记和按类型路由的分配器
+ */
+
+import "test_framework.hpp";
+import SoC.unit_test;
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define REGISTER_TEST_CASE(NAME) TEST_CASE("routing_allocator/" NAME)
+
+namespace
+{
+    /**
+     * @brief 标记为可被DMA访问的operator new/delete封装
+     *
+     */
+    struct dma_allocator : ::SoC::std_allocator
+    {
+        constexpr inline static auto capability{::SoC::memory_capability::dma};
+    };
+
+    /// 仅CPU访问的对象经过缓存，以便区分两个上游分配器
+    using cpu_allocator = ::SoC::frame_cache_allocator<::SoC::std_allocator, 2>;
+    using allocator_t = ::SoC::basic_routing_allocator<::dma_allocator, ::cpu_allocator>;
+
+    /**
+     * @brief 需要DMA访问的缓冲区
+     *
+     */
+    struct dma_buffer
+    {
+        ::std::array<::std::uint32_t, 4> data;
+    };
+
+    /**
+     * @brief 清空缓存并重置统计信息
+     *
+     */
+    void reset() noexcept
+    {
+        ::cpu_allocator::release();
+        ::cpu_allocator::reset_counter();
+        ::SoC::std_allocator::reset();
+    }
+}  // namespace
+
+template <>
+constexpr inline bool ::SoC::requires_dma_access<::dma_buffer>{true};
+
+/// @test 测试内存访问能力标记和按类型路由的分配器
+TEST_SUITE("routing_allocator" * ::doctest::description{"测试内存访问能力标记和按类型路由的分配器"})
+{
+    /// @test 测试分配器的访问能力标记
+    REGISTER_TEST_CASE("capability" * ::doctest::description{"测试分配器的访问能力标记"})
+    {
+        CHECK(::SoC::is_dma_allocator<::dma_allocator>);
+        // 未声明访问能力的分配器视为仅CPU可访问
+        CHECK_FALSE(::SoC::is_dma_allocator<::SoC::std_allocator>);
+        // 缓存分配器继承上游的访问能力
+        CHECK(::SoC::is_dma_allocator<::SoC::frame_cache_allocator<::dma_allocator>>);
+        CHECK_FALSE(::SoC::is_dma_allocator<::allocator_t>);
+        CHECK(::SoC::is_static_allocator<::allocator_t>);
+        CHECK(::SoC::is_dma_allocator<::SoC::ram_heap_allocator_t>);
+        CHECK_FALSE(::SoC::is_dma_allocator<::SoC::ccmram_heap_allocator_t>);
+
+        auto span{::SoC::allocate_span<::std::uint8_t>(::dma_allocator{}, 16)};
+        CHECK(::std::same_as<decltype(span), ::SoC::dma_span<::std::uint8_t>>);
+        CHECK_EQ(span.size(), 16);
+        ::dma_allocator::deallocate(span.data(), span.size());
+        auto cpu_span{::SoC::allocate_span<::std::uint8_t>(::SoC::std_allocator{}, 16)};
+        CHECK_EQ(cpu_span.capability, ::SoC::memory_capability::cpu_only);
+        ::SoC::std_allocator::deallocate(cpu_span.data(), cpu_span.size());
+        ::SoC::std_allocator::reset();
+    }
+
+    /// @test 测试按类型路由的分配器按对象类型标记访问能力
+    REGISTER_TEST_CASE("route capability" * ::doctest::description{"测试按类型路由的分配器按对象类型标记访问能力"})
+    {
+        ::reset();
+        CHECK_EQ(::SoC::allocator_capability_for<::allocator_t, ::dma_buffer>, ::SoC::memory_capability::dma);
+        CHECK_EQ(::SoC::allocator_capability_for<::allocator_t, ::std::uint64_t>, ::SoC::memory_capability::cpu_only);
+        // 未声明capability_for的分配器对所有类型使用同一访问能力
+        CHECK_EQ(::SoC::allocator_capability_for<::dma_allocator, ::std::uint64_t>, ::SoC::memory_capability::dma);
+
+        // 路由到可被DMA访问的内存的缓冲区可以交给DMA
+        auto buffer_span{::SoC::allocate_span<::dma_buffer>(::allocator_t{}, 2)};
+        CHECK(::std::same_as<decltype(buffer_span), ::SoC::dma_span<::dma_buffer>>);
+        CHECK_EQ(buffer_span.size(), 2);
+        CHECK_EQ(::cpu_allocator::get_miss_cnt(), 0);
+        ::allocator_t::deallocate(buffer_span.data(), buffer_span.size());
+
+        auto value_span{::SoC::allocate_span<::std::uint64_t>(::allocator_t{}, 2)};
+        CHECK_EQ(value_span.capability, ::SoC::memory_capability::cpu_only);
+        CHECK_EQ(::cpu_allocator::get_miss_cnt(), 1);
+        ::allocator_t::deallocate(value_span.data(), value_span.size());
+        ::reset();
+    }
+
+    /// @test 测试按类型路由分配和释放
+    REGISTER_TEST_CASE("route" * ::doctest::description{"测试按类型路由分配和释放"})
+    {
+        ::reset();
+        auto* buffer{::allocator_t::allocate<::dma_buffer>()};
+        auto* value{::allocator_t::allocate<::std::uint64_t>()};
+        auto* frame{::allocator_t::allocate(64)};
+        // 仅CPU访问的对象和不带类型的分配经过缓存分配器
+        CHECK_EQ(::cpu_allocator::get_miss_cnt(), 2);
+        CHECK_EQ(::SoC::std_allocator::allocate_cnt, 3);
+
+        ::allocator_t::deallocate(value);
+        ::allocator_t::deallocate(frame, 64);
+        // 被缓存分配器缓存，没有归还operator delete
+        CHECK_EQ(::SoC::std_allocator::deallocate_cnt, 0);
+        ::allocator_t::deallocate(buffer);
+        CHECK_EQ(::SoC::std_allocator::deallocate_cnt, 1);
+        ::reset();
+    }
+}
@@ -0,0 +1,287 @@
+/**
+ * @file scheduler.cpp
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief SoC::basic_scheduler单元测试
+ */
+
+import "test_framework.hpp";
+import SoC.unit_test;
+
+using namespace ::SoC::literal;
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define REGISTER_TEST_CASE(NAME) TEST_CASE("scheduler/" NAME)
+
+namespace
+{
+    using task_t = ::SoC::task_base<::SoC::std_allocator>;
+    using scheduler_t = ::SoC::scheduler<4, 4>;
+    using order_t = ::std::vector<::std::size_t>;
+
+    /**
+     * @brief 模拟的调度器时钟，休眠时直接推进到目标时刻
+     *
+     */
+    struct simulated_clock
+    {
+        /// 当前模拟时刻
+        inline static ::std::uint64_t tick{};
+        /// 每次休眠的目标时刻
+        inline static ::std::vector<::std::uint64_t> sleep_targets{};
+
+        /**
+         * @brief 获取当前模拟时刻
+         *
+         * @return 当前模拟时刻
+         */
+        [[nodiscard]] ::std::uint64_t now() const noexcept { return tick; }
+
+        /**
+         * @brief 记录休眠并推进模拟时刻
+         *
+         * @param target_tick 目标时刻
+         */
+        void sleep_until(::std::uint64_t target_tick) const
+        {
+            sleep_targets.push_back(target_tick);
+            tick = target_tick;
+        }
+    };
+}  // namespace
+
+/// @test SoC::basic_scheduler单元测试
+TEST_SUITE("scheduler" * ::doctest::description{"SoC::basic_scheduler单元测试"})
+{
+    /// @test 测试就绪队列按先进先出顺序执行协程
+    REGISTER_TEST_CASE("ready_queue" * ::doctest::description{"测试就绪队列按先进先出顺序执行协程"})
+    {
+        ::scheduler_t scheduler{};
+        ::order_t order{};
+        auto coro{[](::SoC::scheduler_base& scheduler [[maybe_unused]], ::order_t& order, ::std::size_t id) static -> ::task_t
+                  {
+                      order.push_back(id);
+                      co_return ::std::errc{};
+                  }};
+
+        CHECK(scheduler.empty());
+        for(auto i: ::std::views::iota(0zu, 3zu)) { scheduler.spawn(coro(scheduler, order, i)); }
+        CHECK_EQ(scheduler.get_ready_queue().size(), 3);
+        scheduler.poll();
+        CHECK(scheduler.empty());
+        CHECK_EQ(order, ::order_t{0, 1, 2});
+    }
+
+    /// @test 测试等待队列按到期时刻唤醒协程
+    REGISTER_TEST_CASE("wait_queue" * ::doctest::description{"测试等待队列按到期时刻唤醒协程"})
+    {
+        ::scheduler_t scheduler{};
+        ::order_t order{};
+        auto coro{[](::SoC::scheduler_base& scheduler [[maybe_unused]], ::order_t& order, ::std::size_t id) static -> ::task_t
+                  {
+                      co_await ::SoC::millisecond{id};
+                      order.push_back(id);
+                      co_return ::std::errc{};
+                  }};
+
+        for(auto i: ::std::array{3zu, 1zu, 2zu}) { scheduler.spawn(coro(scheduler, order, i)); }
+        scheduler.poll();
+        CHECK(scheduler.get_ready_queue().empty());
+        CHECK_EQ(scheduler.get_wait_queue().size(), 3);
+        scheduler.run();
+        CHECK(scheduler.empty());
+        CHECK_EQ(order, ::order_t{1, 2, 3});
+    }
+
+    /// @test 测试最早截止时刻优先就绪队列按绝对截止时刻执行协程并统计截止时刻错过
+    REGISTER_TEST_CASE("edf_ready_queue" * ::doctest::description{"测试最早截止时刻优先就绪队列按绝对截止时刻执行协程"})
+    {
+        ::simulated_clock::tick = 0;
+        ::SoC::edf_scheduler<4, 4, ::simulated_clock> scheduler{};
+        ::order_t order{};
+        auto coro{[](::SoC::scheduler_base& scheduler [[maybe_unused]], ::order_t& order, ::std::size_t id) static -> ::task_t
+                  {
+                      order.push_back(id);
+                      co_return ::std::errc{};
+                  }};
+
+        // 相对截止时刻为0的协程没有截止时刻
+        constexpr ::std::array<::std::pair<::std::size_t, ::std::size_t>, 4> id_deadline{
+            {{0, 30}, {1, 0}, {2, 10}, {3, 20}}
+        };
+        for(auto&& [id, deadline]: id_deadline)
+        {
+            auto task{coro(scheduler, order, id)};
+            task.set_relative_deadline(::SoC::microsecond{deadline});
+            CHECK_EQ(task.get_relative_deadline().rep, deadline);
+            scheduler.spawn(::std::move(task));
+        }
+        auto&& ready_queue{scheduler.get_ready_queue()};
+        CHECK_EQ(ready_queue.size(), 4);
+        CHECK_EQ(ready_queue.next_deadline(), 10);
+
+        // 截止时刻为10和20的协程在时刻25才被执行
+        ::simulated_clock::tick = 25;
+        scheduler.poll();
+        CHECK(scheduler.empty());
+        CHECK_EQ(order, ::order_t{2, 3, 0, 1});
+        CHECK_EQ(ready_queue.get_deadline_miss_cnt(), 2);
+        ready_queue.reset_deadline_miss_cnt();
+        CHECK_EQ(ready_queue.get_deadline_miss_cnt(), 0);
+        CHECK_THROWS_WITH_AS_MESSAGE(ready_queue.pop_front(),
+                                     ::doctest::Contains{"最早截止时刻优先就绪队列已空"},
+                                     ::SoC::assert_failed_exception,
+                                     "最早截止时刻优先就绪队列已空时取出协程应断言失败");
+    }
+
+    /// @test 测试空闲时调度器时钟直接休眠到最早截止时刻
+    REGISTER_TEST_CASE("tickless" * ::doctest::description{"测试空闲时调度器时钟直接休眠到最早截止时刻"})
+    {
+        ::simulated_clock::tick = 0;
+        ::simulated_clock::sleep_targets.clear();
+        ::SoC::basic_scheduler<::SoC::fifo_ready_queue<4>, ::SoC::heap_wait_queue<4>, ::simulated_clock> scheduler{};
+        ::order_t order{};
+        auto coro{[](::SoC::scheduler_base& scheduler [[maybe_unused]], ::order_t& order, ::std::size_t id) static -> ::task_t
+                  {
+                      co_await ::SoC::millisecond{id};
+                      order.push_back(id);
+                      co_return ::std::errc{};
+                  }};
+
+        for(auto i: ::std::array{3zu, 1zu, 2zu, 2zu}) { scheduler.spawn(coro(scheduler, order, i)); }
+        scheduler.run();
+        CHECK(scheduler.empty());
+        CHECK_EQ(order, ::order_t{1, 2, 2, 3});
+        // 每个不同的截止时刻仅唤醒一次
+        CHECK_EQ(::simulated_clock::sleep_targets, ::std::vector<::std::uint64_t>{1'000, 2'000, 3'000});
+        CHECK_EQ(::simulated_clock::tick, 3'000);
+    }
+
+    /// @test 测试时间轮调度器以调度器时钟为起点唤醒协程
+    REGISTER_TEST_CASE("wheel_scheduler" * ::doctest::description{"测试时间轮调度器以调度器时钟为起点唤醒协程"})
+    {
+        // 模拟时钟远早于系统时刻，时间轮不能以系统时刻为起点
+        ::simulated_clock::tick = 0;
+        ::simulated_clock::sleep_targets.clear();
+        ::SoC::wheel_scheduler<4, 4, ::simulated_clock> scheduler{};
+        CHECK_EQ(scheduler.get_wait_queue().get_current_tick(), 0);
+        ::order_t order{};
+        auto coro{[](::SoC::scheduler_base& scheduler [[maybe_unused]], ::order_t& order, ::std::size_t id) static -> ::task_t
+                  {
+                      co_await ::SoC::millisecond{id};
+                      order.push_back(id);
+                      co_return ::std::errc{};
+                  }};
+
+        for(auto i: ::std::array{3zu, 1zu, 2zu, 2zu}) { scheduler.spawn(coro(scheduler, order, i)); }
+        scheduler.poll();
+        CHECK_EQ(scheduler.get_wait_queue().size(), 4);
+        CHECK_LE(scheduler.get_wait_queue().next_tick(), 1'000);
+        scheduler.run();
+        CHECK(scheduler.empty());
+        CHECK_EQ(order, ::order_t{1, 2, 2, 3});
+        // 高层定时器下沉时可能多次休眠，但每个截止时刻均准时到达
+        auto&& sleep_targets{::simulated_clock::sleep_targets};
+        CHECK(::std::ranges::is_sorted(sleep_targets));
+        for(auto target: ::std::array<::std::uint64_t, 3>{1'000, 2'000, 3'000})
+        {
+            CHECK_NE(::std::ranges::find(sleep_targets, target), sleep_targets.end());
+        }
+        CHECK_EQ(::simulated_clock::tick, 3'000);
+    }
+
+    /// @test 测试无节拍休眠被提前唤醒时的时刻修正
+    REGISTER_TEST_CASE("tickless wakeup" * ::doctest::description{"测试无节拍休眠被提前唤醒时的时刻修正"})
+    {
+        constexpr ::std::uint32_t cycles{100};
+        const auto check{[](::std::uint32_t remain,
+                            ::std::uint32_t elapsed,
+                            ::std::uint32_t elapsed_ticks,
+                            ::std::uint32_t next_tick_cycles)
+                         {
+                             auto result{::SoC::detail::get_tickless_wakeup(remain, elapsed, cycles)};
+                             CHECK_EQ(result.elapsed_ticks, elapsed_ticks);
+                             CHECK_EQ(result.next_tick_cycles, next_tick_cycles);
+                         }};
+
+        // 尚未到达第一个系统时刻边界
+        check(30, 0, 0, 30);
+        check(30, 29, 0, 1);
+        // 恰好到达第一个系统时刻边界
+        check(30, 30, 1, 100);
+        check(30, 129, 1, 1);
+        // 经过多个系统时刻边界，余下的周期不计入系统时刻但保留相位
+        check(30, 130, 2, 100);
+        check(30, 275, 3, 55);
+        // 休眠开始时恰好位于系统时刻边界
+        check(100, 250, 2, 50);
+        check(0, 250, 3, 50);
+    }
+
+    /// @test 测试分离的协程执行完成后释放协程帧
+    REGISTER_TEST_CASE("detached frame" * ::doctest::description{"测试分离的协程执行完成后释放协程帧"})
+    {
+        ::SoC::std_allocator::reset();
+        auto&& allocate_cnt{::SoC::std_allocator::allocate_cnt};
+        auto&& deallocate_cnt{::SoC::std_allocator::deallocate_cnt};
+
+        ::scheduler_t scheduler{};
+        auto coro{[](::SoC::scheduler_base& scheduler [[maybe_unused]]) static -> ::task_t
+                  {
+                      co_await 1_ms;
+                      co_return ::std::errc{};
+                  }};
+
+        for(auto i{0zu}; i != 4; ++i) { scheduler.spawn(coro(scheduler)); }
+        CHECK_EQ(allocate_cnt, 4);
+        CHECK_EQ(deallocate_cnt, 0);
+        scheduler.run();
+        CHECK_EQ(allocate_cnt, 4);
+        CHECK_EQ(deallocate_cnt, 4);
+
+        // 未分离的任务由任务对象负责释放
+        {
+            auto task{coro(scheduler)};
+            scheduler.ready_queue_push_back(task.get_handle());
+            scheduler.run();
+            CHECK(task.done());
+            CHECK_EQ(deallocate_cnt, 4);
+        }
+        CHECK_EQ(deallocate_cnt, 5);
+    }
+
+    /// @test 测试多级优先级就绪队列优先执行高优先级协程
+    REGISTER_TEST_CASE("priority_ready_queue" * ::doctest::description{"测试多级优先级就绪队列优先执行高优先级协程"})
+    {
+        ::SoC::priority_scheduler<4, 4, 4> scheduler{};
+        ::order_t order{};
+        auto coro{[](::SoC::scheduler_base& scheduler [[maybe_unused]], ::order_t& order, ::std::size_t id) static -> ::task_t
+                  {
+                      order.push_back(id);
+                      co_return ::std::errc{};
+                  }};
+
+        // 优先级超出范围的协程视为最低优先级
+        constexpr ::std::array<::std::pair<::std::size_t, ::std::size_t>, 5> id_priority{
+            {{0, 3}, {1, 1}, {2, 9}, {3, 0}, {4, 1}}
+        };
+        for(auto&& [id, priority]: id_priority)
+        {
+            auto task{coro(scheduler, order, id)};
+            task.set_priority(priority);
+            scheduler.spawn(::std::move(task));
+        }
+        auto&& ready_queue{scheduler.get_ready_queue()};
+        CHECK_EQ(ready_queue.size(), 5);
+        CHECK_EQ(ready_queue.size(0), 1);
+        CHECK_EQ(ready_queue.size(1), 2);
+        CHECK_EQ(ready_queue.size(2), 0);
+        CHECK_EQ(ready_queue.size(3), 2);
+
+        scheduler.poll();
+        CHECK(scheduler.empty());
+        CHECK_EQ(order, ::order_t{3, 1, 4, 0, 2});
+        CHECK_THROWS_WITH_AS_MESSAGE(ready_queue.pop_front(),
+                                     ::doctest::Contains{"优先级就绪队列已空"},
+                                     ::SoC::assert_failed_exception,
+                                     "优先级就绪队列已空时取出协程应断言失败");
+    }
+}
@@ -0,0 +1,106 @@
+/**
+ * @file spsc_ring_buffer.cpp
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief 测试无锁单生产者单消费者环形缓冲区
+ */
+
+import "test_framework.hpp";
+import SoC.unit_test;
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define REGISTER_TEST_CASE(NAME) TEST_CASE("spsc_ring_buffer/" NAME)
+
+/// @test 测试无锁单生产者单消费者环形缓冲区
+TEST_SUITE("spsc_ring_buffer" * ::doctest::description{"测试无锁单生产者单消费者环形缓冲区"})
+{
+    /// @test 测试单线程下的添加和取出
+    REGISTER_TEST_CASE("push_pop" * ::doctest::description{"测试单线程下的添加和取出"})
+    {
+        ::SoC::spsc_ring_buffer<int, 4> buffer{};
+        CHECK(buffer.empty());
+        CHECK_EQ(buffer.capacity(), 4);
+        for(auto i{0}; i != 4; ++i) { CHECK(buffer.try_push(i)); }
+        // 缓冲区已满
+        CHECK_FALSE(buffer.try_push(4));
+        CHECK_EQ(buffer.size(), 4);
+
+        int value{};
+        CHECK(buffer.try_pop(value));
+        CHECK_EQ(value, 0);
+        CHECK(buffer.try_emplace(4));
+        for(auto i{1}; i != 5; ++i)
+        {
+            CHECK(buffer.try_pop(value));
+            CHECK_EQ(value, i);
+        }
+        // 缓冲区已空
+        CHECK_FALSE(buffer.try_pop(value));
+        CHECK(buffer.empty());
+    }
+
+    /// @test 测试批量添加和取出，包括回绕和空间不足的情况
+    REGISTER_TEST_CASE("range" * ::doctest::description{"测试批量添加和取出，包括回绕和空间不足的情况"})
+    {
+        ::SoC::spsc_ring_buffer<int, 4> buffer{};
+        ::std::array input{0, 1, 2, 3, 4, 5};
+        ::std::array<int, 8> output{};
+        // 仅能添加容量个元素
+        CHECK_EQ(buffer.try_push_range(input), 4);
+        CHECK_EQ(buffer.try_pop_range(::std::span{output}.first(2)), 2);
+        CHECK_EQ(output[0], 0);
+        CHECK_EQ(output[1], 1);
+        // 发生回绕
+        CHECK_EQ(buffer.try_push_range(::std::span{input}.subspan(4)), 2);
+        CHECK_EQ(buffer.try_pop_range(output), 4);
+        CHECK(::std::ranges::equal(::std::span{output}.first(4), ::std::span{input}.subspan(2)));
+        CHECK_EQ(buffer.try_pop_range(output), 0);
+
+        // 非平凡类型逐个构造和析构，剩余的元素由析构函数析构
+        ::SoC::spsc_ring_buffer<::std::string, 4> string_buffer{};
+        ::std::array<::std::string, 3> strings{::std::string(32, 'a'), ::std::string(32, 'b'), "c"};
+        CHECK_EQ(string_buffer.try_push_range(strings), 3);
+        ::std::string value{};
+        CHECK(string_buffer.try_pop(value));
+        CHECK_EQ(value, strings[0]);
+    }
+
+    /// @test 测试一个生产者线程和一个消费者线程并发访问
+    REGISTER_TEST_CASE("concurrent" * ::doctest::description{"测试一个生产者线程和一个消费者线程并发访问"})
+    {
+        constexpr ::std::uint32_t total{20'000};
+        ::SoC::spsc_ring_buffer<::std::uint32_t, 16> buffer{};
+        ::std::jthread producer{[&buffer]
+                                {
+                                    for(::std::uint32_t i{}; i != total;)
+                                    {
+                                        if(i % 3 == 0)
+                                        {
+                                            ::std::array<::std::uint32_t, 5> values{};
+                                            ::std::ranges::iota(values, i);
+                                            auto cnt{::std::min<::std::size_t>(values.size(), total - i)};
+                                            i += buffer.try_push_range(::std::span{values}.first(cnt));
+                                        }
+                                        else if(buffer.try_push(i)) { ++i; }
+                                        else
+                                        {
+                                            ::std::this_thread::yield();
+                                        }
+                                    }
+                                }};
+
+        // 消费者交替使用单个和批量取出，检查元素按顺序到达
+        ::std::uint32_t expected{};
+        bool in_order{true};
+        while(expected != total)
+        {
+            ::std::array<::std::uint32_t, 7> values{};
+            auto cnt{expected % 2 == 0 ? static_cast<::std::size_t>(buffer.try_pop(values[0]))
+                                       : buffer.try_pop_range(values)};
+            if(cnt == 0) { ::std::this_thread::yield(); }
+            for(auto value: ::std::span{values}.first(cnt)) { in_order = in_order && value == expected++; }
+        }
+        producer.join();
+        CHECK(in_order);
+        CHECK(buffer.empty());
+    }
+}
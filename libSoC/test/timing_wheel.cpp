@@ -0,0 +1,140 @@
+/**
+ * @file timing_wheel.cpp
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief 测试分层时间轮
+ */
+
+import "test_framework.hpp";
+import SoC.unit_test;
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define REGISTER_TEST_CASE(NAME) TEST_CASE("timing_wheel/" NAME)
+
+namespace SoC::test
+{
+    extern "C++" template <::std::size_t node_cnt, ::std::size_t slot_shift, ::std::size_t level_cnt>
+    struct timing_wheel : ::SoC::timing_wheel<node_cnt, slot_shift, level_cnt>
+    {
+        using base_t = ::SoC::timing_wheel<node_cnt, slot_shift, level_cnt>;
+        using base_t::base_t;
+        using base_t::bitmaps;
+        using base_t::current;
+        using base_t::overflow_slot;
+        using base_t::slots;
+    };
+}  // namespace SoC::test
+
+namespace
+{
+    /// 每层4个槽，共2层，覆盖16个时刻
+    using timing_wheel_t = ::SoC::test::timing_wheel<8, 2, 2>;
+    using fired_t = ::std::vector<::std::uintptr_t>;
+
+    /**
+     * @brief 以整数构造仅用于标识的协程柄，不会被恢复执行
+     *
+     * @param id 标识
+     * @return 协程柄
+     */
+    ::std::coroutine_handle<> make_handle(::std::uintptr_t id) noexcept
+    {
+        // NOLINTNEXTLINE(performance-no-int-to-ptr)
+        return ::std::coroutine_handle<>::from_address(reinterpret_cast<void*>(id));
+    }
+
+    /**
+     * @brief 推进时间轮并记录到期的协程柄
+     *
+     * @param wheel 时间轮
+     * @param now 当前时刻
+     * @return 到期的协程柄标识
+     */
+    ::fired_t expire(::timing_wheel_t& wheel, ::std::uint64_t now)
+    {
+        ::fired_t fired{};
+        wheel.expire(now,
+                     [&fired](::std::coroutine_handle<> handle)
+                     { fired.push_back(reinterpret_cast<::std::uintptr_t>(handle.address())); });
+        return fired;
+    }
+}  // namespace
+
+/// @test 测试分层时间轮
+TEST_SUITE("timing_wheel" * ::doctest::description{"测试分层时间轮"})
+{
+    /// @test 测试定时器按目标时刻到期
+    REGISTER_TEST_CASE("expire" * ::doctest::description{"测试定时器按目标时刻到期"})
+    {
+        ::timing_wheel_t wheel{};
+        wheel.current = 0;
+        CHECK(wheel.empty());
+        CHECK_EQ(wheel.next_tick(), ::std::numeric_limits<::std::uint64_t>::max());
+
+        // 1和3位于第0层，5位于第1层，16和17超出范围位于溢出链表
+        for(auto target: ::std::array{1zu, 5zu, 17zu, 3zu, 16zu}) { wheel.push_back(::make_handle(target), target); }
+        CHECK_EQ(wheel.size(), 5);
+        CHECK_EQ(wheel.bitmaps[0], 0b1010);
+        CHECK_EQ(wheel.bitmaps[1], 0b0010);
+        CHECK_NE(wheel.slots[wheel.overflow_slot], ::timing_wheel_t::invalid_timer_id);
+        CHECK_EQ(wheel.next_tick(), 1);
+
+        CHECK(::expire(wheel, 0).empty());
+        CHECK_EQ(::expire(wheel, 2), ::fired_t{1});
+        CHECK_EQ(wheel.get_current_tick(), 3);
+        CHECK_EQ(::expire(wheel, 4), ::fired_t{3});
+        // 第1层的槽在时刻4下放
+        CHECK_EQ(wheel.next_tick(), 5);
+        CHECK_EQ(::expire(wheel, 15), ::fired_t{5});
+        CHECK_EQ(wheel.next_tick(), 16);
+        CHECK_EQ(::expire(wheel, 100), (::fired_t{16, 17}));
+        CHECK(wheel.empty());
+        CHECK_EQ(wheel.get_current_tick(), 101);
+    }
+
+    /// @test 测试目标时刻早于当前时刻的定时器在下一次推进时到期
+    REGISTER_TEST_CASE("past target" * ::doctest::description{"测试目标时刻早于当前时刻的定时器在下一次推进时到期"})
+    {
+        ::timing_wheel_t wheel{};
+        wheel.current = 40;
+        wheel.push_back(::make_handle(1), 10);
+        CHECK_EQ(wheel.next_tick(), 40);
+        CHECK_EQ(::expire(wheel, 40), ::fired_t{1});
+    }
+
+    /// @test 测试取消定时器
+    REGISTER_TEST_CASE("cancel" * ::doctest::description{"测试取消定时器"})
+    {
+        ::timing_wheel_t wheel{};
+        wheel.current = 0;
+        auto id1{wheel.insert(::make_handle(1), 6)};
+        auto id2{wheel.insert(::make_handle(2), 6)};
+        auto id3{wheel.insert(::make_handle(3), 100)};
+        CHECK_EQ(wheel.size(), 3);
+
+        wheel.cancel(id1);
+        wheel.cancel(id3);
+        CHECK_EQ(wheel.size(), 1);
+        CHECK_EQ(wheel.slots[wheel.overflow_slot], ::timing_wheel_t::invalid_timer_id);
+        CHECK_EQ(::expire(wheel, 10), ::fired_t{2});
+        CHECK_EQ(wheel.bitmaps[0], 0);
+        CHECK_EQ(wheel.bitmaps[1], 0);
+
+        CHECK_THROWS_WITH_AS_MESSAGE(wheel.cancel(id2),
+                                     ::doctest::Contains{"要取消的定时器不存在或已到期"},
+                                     ::SoC::assert_failed_exception,
+                                     "取消已到期的定时器应断言失败");
+    }
+
+    /// @test 测试定时器节点用尽
+    REGISTER_TEST_CASE("exhausted" * ::doctest::description{"测试定时器节点用尽"})
+    {
+        ::timing_wheel_t wheel{};
+        for(auto i{1zu}; i != 9; ++i) { wheel.push_back(::make_handle(i), wheel.get_current_tick() + i); }
+        CHECK_THROWS_WITH_AS_MESSAGE(wheel.push_back(::make_handle(9), wheel.get_current_tick()),
+                                     ::doctest::Contains{"时间轮定时器节点已用尽"},
+                                     ::SoC::assert_failed_exception,
+                                     "定时器节点用尽时插入应断言失败");
+        CHECK_EQ(::expire(wheel, wheel.get_current_tick() + 8).size(), 8);
+        CHECK(wheel.empty());
+    }
+}
@@ -141,6 +141,32 @@ namespace SoC
 
     extern "C++" void yield_cpu() noexcept(::SoC::optional_noexcept) { ::std::this_thread::yield(); }
 
+    /// 模拟中断屏蔽的全局自旋锁
+    constinit ::std::atomic_flag critical_section_lock{};
+    /// 当前线程进入临界区的嵌套深度
+    constinit thread_local ::std::size_t critical_section_depth{};
+
+    extern "C++" ::std::uintptr_t enter_critical_section() noexcept
+    {
+        if(critical_section_depth++ == 0)
+        {
+            while(critical_section_lock.test_and_set(::std::memory_order_acquire))
+            {
+                critical_section_lock.wait(true, ::std::memory_order_relaxed);
+            }
+        }
+        return 0;
+    }
+
+    extern "C++" void exit_critical_section(::std::uintptr_t state [[maybe_unused]]) noexcept
+    {
+        if(--critical_section_depth == 0)
+        {
+            critical_section_lock.clear(::std::memory_order_release);
+            critical_section_lock.notify_one();
+        }
+    }
+
     /**
      * @brief 获取当前系统时刻
      *
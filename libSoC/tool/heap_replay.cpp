@@ -0,0 +1,265 @@
+/**
+ * @file heap_replay.cpp
+ * @author 24bit-xjkp (2283572185@qq.com)
+ * @brief 在宿主平台上回放堆跟踪转储，统计各分配器的延迟分位数和峰值碎片率
+ *
+ * 用法: heap_replay <跟踪转储文件> [堆大小(KiB)，默认为128]
+ * @note 链接SoC.freestanding.tool，堆实现与目标平台相同，不启用全部断言和sanitizer；应在release模式下构建
+ */
+
+import std;
+import SoC.freestanding;
+
+static_assert(!::SoC::in_unit_test && !::SoC::use_full_assert,
+              "单元测试中的堆方法为虚函数且启用了全部断言，测得的延迟不能代表目标平台上的堆");
+
+namespace SoC
+{
+    extern "C++" void assert_failed(::std::string_view message, ::std::source_location location)
+    {
+        throw ::std::runtime_error{::std::format("{}({}:{}): 函数 `{}` 中断言失败: {}",
+                                                 location.file_name(),
+                                                 location.line(),
+                                                 location.column(),
+                                                 location.function_name(),
+                                                 message)};
+    }
+
+    /// 回放时不记录跟踪事件，因此系统时刻无实际意义
+    extern "C++" ::std::uint64_t get_systick() noexcept(::SoC::optional_noexcept) { return 0; }
+}  // namespace SoC
+
+namespace
+{
+    /**
+     * @brief 读取跟踪转储文件
+     *
+     * @param path 文件路径
+     * @return 按时间顺序排列的事件和因环形缓冲区被覆盖而丢失的事件数
+     */
+    ::std::pair<::std::vector<::SoC::heap_trace_event>, ::std::size_t> read_trace(const char* path)
+    {
+        ::std::ifstream file{path, ::std::ios::binary};
+        if(!file) { throw ::std::runtime_error{::std::format("无法打开跟踪转储文件: {}", path)}; }
+        ::SoC::heap_trace_header header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        if(!file || header.magic != ::SoC::heap_trace_header::magic_value)
+        {
+            throw ::std::runtime_error{"跟踪转储文件头部无效"};
+        }
+        ::std::vector<::SoC::heap_trace_event> events(header.event_cnt);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        file.read(reinterpret_cast<char*>(events.data()), static_cast<::std::streamsize>(events.size() * sizeof(events.front())));
+        if(!file) { throw ::std::runtime_error{"跟踪转储文件被截断"}; }
+        return ::std::pair{::std::move(events), header.dropped_cnt};
+    }
+
+    /**
+     * @brief 以SoC::heap为后端，使用宿主内存模拟堆区
+     *
+     */
+    struct soc_heap_backend
+    {
+        constexpr inline static ::std::string_view name{"SoC::heap"};
+
+        ::std::unique_ptr<::std::uintptr_t[]> memory;  // NOLINT(*-avoid-c-arrays)
+        ::std::optional<::SoC::heap> heap{};
+
+        explicit soc_heap_backend(::std::size_t size) :
+            // 多分配一页用于对齐堆起始地址
+            memory{::std::make_unique<::std::uintptr_t[]>(  // NOLINT(*-avoid-c-arrays)
+                (size + ::SoC::heap::page_size) / sizeof(::std::uintptr_t))}
+        {
+            void* begin{memory.get()};
+            auto space{size + ::SoC::heap::page_size};
+            ::std::align(::SoC::heap::page_size, size, begin, space);
+            auto* heap_begin{static_cast<::std::uintptr_t*>(begin)};
+            heap.emplace(heap_begin, heap_begin + (size / sizeof(::std::uintptr_t)));
+        }
+
+        void* allocate(::std::size_t size) { return heap->allocate(size); }
+
+        void deallocate(void* ptr, ::std::size_t size) { heap->deallocate(ptr, size); }
+
+        /**
+         * @brief 获取伙伴系统的外部碎片率，即伙伴系统空闲页中不属于最长连续空闲页段的比例
+         *
+         * 分子和分母均只统计伙伴系统中的空闲页块。尚未被page_gc回收的空闲已分块页不计入，
+         * 因此小块突发释放后的未回收页不会被误计为碎片
+         * @return 外部碎片率
+         */
+        [[nodiscard]] double get_fragmentation() const noexcept
+        {
+            auto free_run_pages{heap->get_free_run_pages()};
+            if(free_run_pages == 0) { return 0.; }
+            return 1. - (static_cast<double>(heap->get_largest_free_run()) / static_cast<double>(free_run_pages));
+        }
+    };
+
+    /**
+     * @brief 以宿主平台的operator new/delete为后端
+     *
+     */
+    struct system_backend
+    {
+        constexpr inline static ::std::string_view name{"operator new"};
+
+        static void* allocate(::std::size_t size) { return ::operator new (size); }
+
+        static void deallocate(void* ptr, ::std::size_t size) { ::operator delete (ptr, size); }
+    };
+
+    /**
+     * @brief 以std::pmr::unsynchronized_pool_resource为后端
+     *
+     */
+    struct pool_backend
+    {
+        constexpr inline static ::std::string_view name{"pmr::unsynchronized_pool_resource"};
+
+        ::std::pmr::unsynchronized_pool_resource resource{};
+
+        void* allocate(::std::size_t size) { return resource.allocate(size); }
+
+        void deallocate(void* ptr, ::std::size_t size) { resource.deallocate(ptr, size); }
+    };
+
+    /**
+     * @brief 回放结果
+     *
+     */
+    struct replay_result
+    {
+        /// 每次分配的耗时
+        ::std::vector<::std::chrono::nanoseconds> allocate_latency{};
+        /// 每次释放的耗时
+        ::std::vector<::std::chrono::nanoseconds> deallocate_latency{};
+        /// 找不到对应分配事件而跳过的释放事件数
+        ::std::size_t skipped_cnt{};
+        /// 峰值外部碎片率，后端不支持时为空
+        ::std::optional<double> peak_fragmentation{};
+    };
+
+    /**
+     * @brief 在后端上按顺序回放事件
+     *
+     * @param backend 分配器后端
+     * @param events 事件列表
+     * @return 回放结果
+     */
+    ::replay_result replay(auto& backend, ::std::span<const ::SoC::heap_trace_event> events)
+    {
+        using clock = ::std::chrono::steady_clock;
+        ::replay_result result{};
+        // 跟踪中的块偏移量到回放中的块地址和大小的映射
+        ::std::unordered_map<::std::uint32_t, ::std::pair<void*, ::std::size_t>> live_blocks{};
+        for(auto&& event: events)
+        {
+            auto size{static_cast<::std::size_t>(event.get_size())};
+            if(!event.is_deallocate())
+            {
+                auto begin{clock::now()};
+                auto* ptr{backend.allocate(size)};
+                result.allocate_latency.push_back(clock::now() - begin);
+                live_blocks.insert_or_assign(event.offset, ::std::pair{ptr, size});
+            }
+            else if(auto iter{live_blocks.find(event.offset)}; iter != live_blocks.end())
+            {
+                auto [ptr, allocated_size]{iter->second};
+                auto begin{clock::now()};
+                backend.deallocate(ptr, allocated_size);
+                result.deallocate_latency.push_back(clock::now() - begin);
+                live_blocks.erase(iter);
+            }
+            else
+            {
+                // 对应的分配发生在跟踪窗口之前
+                ++result.skipped_cnt;
+            }
+
+            if constexpr(requires { backend.get_fragmentation(); })
+            {
+                result.peak_fragmentation = ::std::max(result.peak_fragmentation.value_or(0.), backend.get_fragmentation());
+            }
+        }
+        for(auto&& [ptr, size]: live_blocks | ::std::views::values) { backend.deallocate(ptr, size); }
+        return result;
+    }
+
+    /**
+     * @brief 输出延迟分位数
+     *
+     * @param label 操作名称
+     * @param latency 每次操作的耗时
+     */
+    void print_latency(::std::string_view label, ::std::vector<::std::chrono::nanoseconds>& latency)
+    {
+        if(latency.empty())
+        {
+            ::std::println("  {}: 无事件", label);
+            return;
+        }
+        ::std::ranges::sort(latency);
+        auto percentile{[&latency](double p)
+                        { return latency[static_cast<::std::size_t>(p * static_cast<double>(latency.size() - 1))]; }};
+        ::std::println("  {}: {}次, p50 {}, p90 {}, p99 {}, p99.9 {}, max {}",
+                       label,
+                       latency.size(),
+                       percentile(0.5),
+                       percentile(0.9),
+                       percentile(0.99),
+                       percentile(0.999),
+                       latency.back());
+    }
+
+    /**
+     * @brief 在后端上回放事件并输出结果
+     *
+     * @param backend 分配器后端
+     * @param events 事件列表
+     */
+    void run(auto&& backend, ::std::span<const ::SoC::heap_trace_event> events)
+    {
+        ::std::println("{}:", backend.name);
+        try
+        {
+            auto result{::replay(backend, events)};
+            print_latency("分配", result.allocate_latency);
+            print_latency("释放", result.deallocate_latency);
+            if(result.skipped_cnt != 0) { ::std::println("  跳过释放事件: {}次", result.skipped_cnt); }
+            if(result.peak_fragmentation)
+            {
+                ::std::println("  伙伴系统峰值外部碎片率: {:.2f}%", *result.peak_fragmentation * 100);
+            }
+        }
+        catch(const ::std::exception& error)
+        {
+            ::std::println("  回放失败: {}", error.what());
+        }
+    }
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    auto args{::std::span{argv, static_cast<::std::size_t>(argc)}};
+    if(args.size() < 2)
+    {
+        ::std::println(::std::cerr, "用法: {} <跟踪转储文件> [堆大小(KiB)，默认为128]", args.front());
+        return 1;
+    }
+    try
+    {
+        auto heap_size{(args.size() > 2 ? ::std::stoull(args[2]) : 128zu) * 1024};
+        auto [events, dropped_cnt]{::read_trace(args[1])};
+        ::std::println("事件数: {}, 丢失事件数: {}", events.size(), dropped_cnt);
+
+        ::run(::soc_heap_backend{heap_size}, events);
+        ::run(::system_backend{}, events);
+        ::run(::pool_backend{}, events);
+    }
+    catch(const ::std::exception& error)
+    {
+        ::std::println(::std::cerr, "{}", error.what());
+        return 1;
+    }
+}
@@ -0,0 +1,11 @@
+set_arch(os.arch())
+set_plat(get_config("host"))
+
+target("heap_replay")
+    add_files("heap_replay.cpp")
+    add_deps("SoC.freestanding.tool")
+    set_values("stm32_pc.uninstrumented", true)
+    set_kind("binary")
+    set_default(false)
+    set_enabled(is_current_mode_support_unit_test())
+target_end()
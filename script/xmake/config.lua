@@ -18,7 +18,7 @@ rule("stm32_pc", function()
         if target:is_arch("arm") and target:is_plat("cross") then
             target:set("exceptions", "no-cxx")
             target:set("policy", "build.c++.modules.std", false)
-            target:add("options", "assert")
+            target:add("options", "assert", "heap_statistics", "heap_trace")
             target:add("cxflags", "-mtune=cortex-m4", "-ffunction-sections", "-fdata-sections",
                 table.unpack(warning_flags))
             target:add("cxxflags", "-fno-rtti", "-Wno-psabi")
@@ -27,9 +27,13 @@ rule("stm32_pc", function()
             target:set("toolchains", get_config("toolchain"))
         else
             target:set("exceptions", "cxx")
-            target:add("defines", "USE_FULL_ASSERT")
+            -- 宿主平台工具用于测量性能，不启用全部断言和sanitizer
+            local uninstrumented = target:values("stm32_pc.uninstrumented")
+            if not uninstrumented then
+                target:add("defines", "USE_FULL_ASSERT")
+            end
             -- fuzzer下默认启用asan/ubsan
-            if not is_mode("fuzzer") then
+            if not is_mode("fuzzer") and not uninstrumented then
                 target:set("policy", "build.sanitizer.address", get_config("unit_test_with_asan"))
                 target:set("policy", "build.sanitizer.undefined", get_config("unit_test_with_ubsan"))
             end
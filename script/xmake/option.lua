@@ -4,6 +4,18 @@ option("assert", function()
     add_defines("USE_FULL_ASSERT")
 end)
 
+option("heap_statistics", function()
+    set_default(false)
+    set_description("Whether to record allocation statistics in SoC::heap.")
+    add_defines("SOC_HEAP_STATISTICS")
+end)
+
+option("heap_trace", function()
+    set_default(false)
+    set_description("Whether to support recording allocation events of SoC::heap into a trace ring.")
+    add_defines("SOC_HEAP_TRACE")
+end)
+
 option("unit_test_with_asan", function()
     set_default(true)
     set_description("Whether to build unit test with address sanitizer.")
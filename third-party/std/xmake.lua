@@ -4,6 +4,9 @@ if is_current_mode_support_fuzzer() then
 end
 if is_current_mode_support_unit_test() then
     test_table["unit_test"] = function () end
+    test_table["tool"] = function ()
+        set_values("stm32_pc.uninstrumented", true)
+    end
 end
 register_target_with_test("SoC.std", function ()
     set_kind("object")